@@ -355,10 +355,13 @@ void SetEdgPar(MshSct *msh, int NmbCpu)
    HshSct *HshTab;
    ParSct par[ MaxPth ];
 
-   // Setup LPlib and datatypes
+   // Setup LPlib and datatypes, the threads' parameters being sized
+   // for MaxPth threads
    if(!NmbCpu)
       NmbCpu = GetNumberOfCores();
 
+   NmbCpu = MIN(NmbCpu, MaxPth);
+
    printf("Build edges with %3d threads: ", NmbCpu);
 
    GetTim(&timer);
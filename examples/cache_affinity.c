@@ -0,0 +1,199 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     CACHE AFFINITY CHECK USING LPLib4                      */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       run a dependency loop whose blocks are sorted by      */
+/*                      number of dependencies and check that, with cache     */
+/*                      affinity, threads mostly go on with the block that    */
+/*                      follows or precedes the one they just completed       */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 18 2026                                           */
+/*   Last modification: oct 18 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "lplib4.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbLin 400000
+#define NmbVer (NmbLin + 1)
+
+
+/*----------------------------------------------------------------------------*/
+/* Structures' prototypes                                                     */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+   int      (*ver)[3], *own;
+   int64_t  cnf, NmbBlk, NmbNgb;
+   int      BegIdx[ MaxPth ], EndIdx[ MaxPth ];
+   double   *vec;
+}ArgSct;
+
+
+/*----------------------------------------------------------------------------*/
+/* Update the line's vertices and count the blocks that follow or precede     */
+/* the last one run by the same thread                                        */
+/*----------------------------------------------------------------------------*/
+
+void LinWrk(int BegIdx, int EndIdx, int PthIdx, ArgSct *arg)
+{
+   int i, j, v;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      for(j=0;j<3;j++)
+      {
+         v = arg->ver[i][j];
+
+         if(arg->own[v] && (arg->own[v] != PthIdx + 1))
+            arg->cnf++;
+
+         arg->own[v] = PthIdx + 1;
+         arg->vec[v] += 1.;
+      }
+
+      for(j=0;j<3;j++)
+         arg->own[ arg->ver[i][j] ] = 0;
+   }
+
+   // Blocks are handed out one at a time, so the counters are not shared
+   if(PthIdx >= MaxPth)
+      return;
+
+   arg->NmbBlk++;
+
+   if( (BegIdx == arg->EndIdx[ PthIdx ] + 1) || (EndIdx + 1 == arg->BegIdx[ PthIdx ]) )
+      arg->NmbNgb++;
+
+   arg->BegIdx[ PthIdx ] = BegIdx;
+   arg->EndIdx[ PthIdx ] = EndIdx;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the loop with or without cache affinity and return the ratio of        */
+/* blocks that were neighbours of the thread's previous one                   */
+/*----------------------------------------------------------------------------*/
+
+static double RunLch(int NmbCpu, int aff, ArgSct *arg)
+{
+   int      i, j, LinTyp, VerTyp;
+   int64_t  LibParIdx;
+   float    sta[2];
+
+   if(!(LibParIdx = InitParallel(NmbCpu)))
+   {
+      puts("Error initializing the LPLib4.");
+      exit(1);
+   }
+
+   if(aff)
+      SetExtendedAttributes(LibParIdx, EnableCacheAffinity);
+
+   if(!(LinTyp = NewType(LibParIdx, NmbLin))
+   || !(VerTyp = NewType(LibParIdx, NmbVer)))
+   {
+      puts("Error while creating the types.");
+      exit(1);
+   }
+
+   BeginDependency(LibParIdx, LinTyp, VerTyp);
+
+   for(i=1;i<=NmbLin;i++)
+      for(j=0;j<3;j++)
+         AddDependency(LibParIdx, i, arg->ver[i][j]);
+
+   EndDependency(LibParIdx, sta);
+
+   // Only the first launch is checked: threads have no blocks of their own
+   // yet and the shared list is sorted, so following neighbours is the only
+   // way to run consecutive blocks
+   arg->cnf = arg->NmbBlk = arg->NmbNgb = 0;
+
+   for(i=0;i<MaxPth;i++)
+      arg->BegIdx[i] = arg->EndIdx[i] = -1;
+
+   if(LaunchParallel(LibParIdx, LinTyp, VerTyp, (void *)LinWrk, (void *)arg) < 0)
+   {
+      puts("Error while running the loop.");
+      exit(1);
+   }
+
+   StopParallel(LibParIdx);
+
+   printf("cache affinity %s: %lld blocks, %lld neighbours, %lld conflicts\n",
+            aff ? "on " : "off", (long long)arg->NmbBlk,
+            (long long)arg->NmbNgb, (long long)arg->cnf);
+
+   if(arg->cnf || !arg->NmbBlk)
+      return(-1.);
+
+   return((double)arg->NmbNgb / arg->NmbBlk);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* The main procedure reads the number of threads to launch, 4 by default     */
+/*----------------------------------------------------------------------------*/
+
+int main(int ArgCnt, char **ArgVec)
+{
+   int      i, NmbCpu = 4, ok;
+   double   off, on;
+   ArgSct   arg;
+
+   // Read the command line arguments
+   if(ArgCnt > 1)
+      NmbCpu = atoi(*++ArgVec);
+
+   arg.ver = malloc((NmbLin + 1) * 3 * sizeof(int));
+   arg.own = calloc(NmbVer + 1, sizeof(int));
+   arg.vec = calloc(NmbVer + 1, sizeof(double));
+
+   if(!arg.ver || !arg.own || !arg.vec)
+   {
+      puts("malloc failed");
+      exit(1);
+   }
+
+   // Line i writes to vertices i and i+1, and the lines of one chunk
+   // out of three to a random vertex too, so that the blocks get
+   // different numbers of dependencies and are sorted out of index order
+   srand(1);
+
+   for(i=1;i<=NmbLin;i++)
+   {
+      arg.ver[i][0] = i;
+      arg.ver[i][1] = i + 1;
+      arg.ver[i][2] = ((i / 1000) % 3) ? i : rand() % NmbVer + 1;
+   }
+
+   off = RunLch(NmbCpu, 0, &arg);
+   on = RunLch(NmbCpu, 1, &arg);
+
+   free(arg.ver);
+   free(arg.own);
+   free(arg.vec);
+
+   ok = (off >= 0.) && (on > .2) && (on > 4. * off);
+   printf("neighbour blocks ratio: %g without affinity, %g with\n", off, on);
+   puts(ok ? "cache affinity: ok" : "cache affinity: FAILED");
+
+   return(!ok);
+}
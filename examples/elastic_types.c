@@ -0,0 +1,239 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                 ELASTIC TYPES DEPENDENCY TEST USING LPLib4                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       grow, shrink and grow again a type and the one it     */
+/*                      depends on and check that the dependency loop never   */
+/*                      runs two lines sharing a vertex at the same time      */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 18 2026                                           */
+/*   Last modification: oct 18 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "lplib4.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define IniLin 200000
+#define MaxLin (4 * IniLin)
+#define NmbHub 50000
+#define NmbRun 3
+
+
+/*----------------------------------------------------------------------------*/
+/* Structures' prototypes                                                     */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+   int      NmbLin, NmbVer, *own;
+   int64_t  cnf;
+   double   *vec;
+}ArgSct;
+
+
+/*----------------------------------------------------------------------------*/
+/* Line i writes to vertices i and i+1 and each pack of 64 lines to a shared  */
+/* vertex taken at random among the first ones, which ties far apart lines    */
+/*----------------------------------------------------------------------------*/
+
+static int GetVer(int LinIdx, int j)
+{
+   if(j < 2)
+      return(LinIdx + j);
+
+   return((int)(((int64_t)((LinIdx - 1) / 64) * 7919) % NmbHub) + 1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Each line takes its vertices, updates them and releases them,              */
+/* a vertex already taken by another thread is a dependency conflict          */
+/*----------------------------------------------------------------------------*/
+
+void LinWrk(int BegIdx, int EndIdx, int PthIdx, ArgSct *arg)
+{
+   int i, j, v;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      for(j=0;j<3;j++)
+      {
+         v = GetVer(i, j);
+
+         if(arg->own[v] && (arg->own[v] != PthIdx + 1))
+            arg->cnf++;
+
+         arg->own[v] = PthIdx + 1;
+         arg->vec[v] += 1.;
+      }
+
+      for(j=0;j<3;j++)
+         arg->own[ GetVer(i, j) ] = 0;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set the dependencies of a range of lines with UpdateDependency             */
+/*----------------------------------------------------------------------------*/
+
+static int SetDep(int64_t LibParIdx, int LinTyp, int VerTyp, int BegIdx, int EndIdx)
+{
+   int i, j;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      for(j=0;j<3;j++)
+         if(!UpdateDependency(LibParIdx, LinTyp, VerTyp, i, GetVer(i, j)))
+            return(0);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the dependency loop a few times and check that every vertex update     */
+/* went through and that no vertex was shared by two running lines            */
+/*----------------------------------------------------------------------------*/
+
+static int ChkLch(int64_t LibParIdx, int LinTyp, int VerTyp, ArgSct *arg, char *stp)
+{
+   int      i, r;
+   float    acc = 0.;
+   double   sum = 0.;
+
+   for(i=1;i<=arg->NmbVer;i++)
+      arg->vec[i] = 0.;
+
+   arg->cnf = 0;
+
+   for(r=0;r<NmbRun;r++)
+      acc += LaunchParallel(LibParIdx, LinTyp, VerTyp, (void *)LinWrk, (void *)arg);
+
+   for(i=1;i<=arg->NmbVer;i++)
+      sum += arg->vec[i];
+
+   printf("%-14s: %7d lines, %7d vertices, concurrency %g, %lld conflicts\n",
+            stp, arg->NmbLin, arg->NmbVer, acc / NmbRun, (long long)arg->cnf);
+
+   return(!arg->cnf && (acc > 0.) && (sum == 3. * NmbRun * arg->NmbLin));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* The main procedure reads the number of threads to launch, all by default   */
+/*----------------------------------------------------------------------------*/
+
+int main(int ArgCnt, char **ArgVec)
+{
+   int      i, j, NmbCpu = 0, LinTyp, VerTyp, OldLin, ok = 1;
+   int64_t  LibParIdx;
+   float    sta[2];
+   ArgSct   arg;
+
+   // Read the command line arguments
+   if(ArgCnt > 1)
+      NmbCpu = atoi(*++ArgVec);
+
+   arg.own = calloc(MaxLin + 2, sizeof(int));
+   arg.vec = calloc(MaxLin + 2, sizeof(double));
+
+   if(!arg.own || !arg.vec)
+   {
+      puts("malloc failed");
+      exit(1);
+   }
+
+   if(!(LibParIdx = InitParallel(NmbCpu)))
+   {
+      puts("Error initializing the LPLib4.");
+      exit(1);
+   }
+
+   arg.NmbLin = IniLin;
+   arg.NmbVer = IniLin + 1;
+
+   if(!(LinTyp = NewType(LibParIdx, arg.NmbLin))
+   || !(VerTyp = NewType(LibParIdx, arg.NmbVer)))
+   {
+      puts("Error while creating the types.");
+      exit(1);
+   }
+
+   BeginDependency(LibParIdx, LinTyp, VerTyp);
+
+   for(i=1;i<=arg.NmbLin;i++)
+      for(j=0;j<3;j++)
+         AddDependency(LibParIdx, i, GetVer(i, j));
+
+   EndDependency(LibParIdx, sta);
+
+   ok &= ChkLch(LibParIdx, LinTyp, VerTyp, &arg, "initial");
+
+   // Grow the vertices first so that the new lines' dependencies exist,
+   // the former lines keep theirs
+   OldLin = arg.NmbLin;
+   arg.NmbLin = MaxLin;
+   arg.NmbVer = MaxLin + 1;
+
+   if(!ResizeType(LibParIdx, VerTyp, arg.NmbVer)
+   || !ResizeType(LibParIdx, LinTyp, arg.NmbLin)
+   || !SetDep(LibParIdx, LinTyp, VerTyp, OldLin + 1, arg.NmbLin))
+   {
+      puts("Error while growing the types.");
+      exit(1);
+   }
+
+   ok &= ChkLch(LibParIdx, LinTyp, VerTyp, &arg, "grown");
+
+   // Shrink below the initial size, the lines left keep their dependencies
+   arg.NmbLin = IniLin / 2;
+   arg.NmbVer = IniLin / 2 + 1;
+
+   if(!ResizeType(LibParIdx, LinTyp, arg.NmbLin)
+   || !ResizeType(LibParIdx, VerTyp, arg.NmbVer))
+   {
+      puts("Error while shrinking the types.");
+      exit(1);
+   }
+
+   ok &= ChkLch(LibParIdx, LinTyp, VerTyp, &arg, "shrunk");
+
+   // Grow again past the former sizes
+   OldLin = arg.NmbLin;
+   arg.NmbLin = MaxLin;
+   arg.NmbVer = MaxLin + 1;
+
+   if(!ResizeType(LibParIdx, VerTyp, arg.NmbVer)
+   || !ResizeType(LibParIdx, LinTyp, arg.NmbLin)
+   || !SetDep(LibParIdx, LinTyp, VerTyp, OldLin + 1, arg.NmbLin))
+   {
+      puts("Error while growing the types again.");
+      exit(1);
+   }
+
+   ok &= ChkLch(LibParIdx, LinTyp, VerTyp, &arg, "grown again");
+
+   StopParallel(LibParIdx);
+
+   free(arg.own);
+   free(arg.vec);
+
+   puts(ok ? "elastic types: ok" : "elastic types: FAILED");
+
+   return(!ok);
+}
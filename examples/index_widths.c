@@ -0,0 +1,247 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                 32 AND 64 BIT INDICES CHECK USING LPLib4                   */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       run the same loops through the 32 and 64 bit entry    */
+/*                      points of a single library and compare the results    */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 18 2026                                           */
+/*   Last modification: oct 18 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "lplib4.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbVer 200000
+#define NmbEdg (NmbVer - 1)
+
+
+/*----------------------------------------------------------------------------*/
+/* Global tables written by both flavours                                     */
+/*----------------------------------------------------------------------------*/
+
+static int64_t Ver32[ NmbVer + 1 ], Ver64[ NmbVer + 1 ];
+
+
+/*----------------------------------------------------------------------------*/
+/* Same procedures with 32 and 64 bit indices                                 */
+/*----------------------------------------------------------------------------*/
+
+void AddIdx32(int32_t BegIdx, int32_t EndIdx, int PthIdx, int64_t *vec)
+{
+   int32_t i;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      vec[i] += i;
+}
+
+void AddIdx64(int64_t BegIdx, int64_t EndIdx, int PthIdx, int64_t *vec)
+{
+   int64_t i;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      vec[i] += i;
+}
+
+void IncTwo32(int32_t BegIdx, int32_t EndIdx, int PthIdx, int64_t *vec1, int64_t *vec2)
+{
+   int32_t i;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      vec1[i]++;
+      vec2[i]++;
+   }
+}
+
+void IncTwo64(int64_t BegIdx, int64_t EndIdx, int PthIdx, int64_t *vec1, int64_t *vec2)
+{
+   int64_t i;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      vec1[i]++;
+      vec2[i]++;
+   }
+}
+
+void EdgVer32(int32_t BegIdx, int32_t EndIdx, int PthIdx, int32_t *EdgTab)
+{
+   int32_t i;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      Ver32[ EdgTab[ 2 * i ] ]++;
+      Ver32[ EdgTab[ 2 * i + 1 ] ]++;
+   }
+}
+
+void EdgVer64(int64_t BegIdx, int64_t EndIdx, int PthIdx, int64_t *EdgTab)
+{
+   int64_t i;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      Ver64[ EdgTab[ 2 * i ] ]++;
+      Ver64[ EdgTab[ 2 * i + 1 ] ]++;
+   }
+}
+
+float VerCst32(int32_t idx, void *arg)
+{
+   return((float)(idx % 7 + 1));
+}
+
+float VerCst64(int64_t idx, void *arg)
+{
+   return((float)(idx % 7 + 1));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Each vertex is shared by two edges but the first and last ones             */
+/*----------------------------------------------------------------------------*/
+
+static int ChkVer(int64_t fac)
+{
+   int i;
+
+   for(i=1;i<=NmbVer;i++)
+      if( (Ver32[i] != Ver64[i])
+      ||  (Ver32[i] != fac * (((i == 1) || (i == NmbVer)) ? 1 : 2)) )
+      {
+         return(0);
+      }
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* The main procedure reads the number of threads to launch, 8 by default     */
+/*----------------------------------------------------------------------------*/
+
+int main(int ArgCnt, char **ArgVec)
+{
+   int      i, NmbCpu = 8, VerTyp, EdgTyp32, EdgTyp64, GrfIdx, ok = 1, res;
+   int32_t  *Edg32;
+   int64_t  LibParIdx, *Edg64;
+   float    sta[2];
+
+   // Read the command line arguments
+   if(ArgCnt > 1)
+      NmbCpu = atoi(*++ArgVec);
+
+   Edg32 = malloc((NmbEdg + 1) * 2 * sizeof(int32_t));
+   Edg64 = malloc((NmbEdg + 1) * 2 * sizeof(int64_t));
+
+   if(!Edg32 || !Edg64)
+   {
+      puts("malloc failed");
+      exit(1);
+   }
+
+   for(i=1;i<=NmbEdg;i++)
+   {
+      Edg32[ 2 * i ] = Edg64[ 2 * i ] = i;
+      Edg32[ 2 * i + 1 ] = Edg64[ 2 * i + 1 ] = i + 1;
+   }
+
+   if(!(LibParIdx = InitParallel(NmbCpu)))
+   {
+      puts("Error initializing the LPLib4.");
+      exit(1);
+   }
+
+   if(!(VerTyp = NewType(LibParIdx, NmbVer))
+   || !(EdgTyp32 = NewType(LibParIdx, NmbEdg))
+   || !(EdgTyp64 = NewType(LibParIdx, NmbEdg)))
+   {
+      puts("Error while creating the types.");
+      exit(1);
+   }
+
+   // Plain and multiple arguments loops
+   LaunchParallel32(LibParIdx, VerTyp, 0, (void *)AddIdx32, (void *)Ver32);
+   LaunchParallel64(LibParIdx, VerTyp, 0, (void *)AddIdx64, (void *)Ver64);
+   LaunchParallelMultiArg32(LibParIdx, VerTyp, 0, (void *)IncTwo32, 2, Ver32, Ver64);
+   LaunchParallelMultiArg64(LibParIdx, VerTyp, 0, (void *)IncTwo64, 2, Ver32, Ver64);
+
+   for(i=1;i<=NmbVer;i++)
+      if( (Ver32[i] != i + 2) || (Ver64[i] != i + 2) )
+         break;
+
+   printf("plain and multiple arguments loops : %s\n", (i > NmbVer) ? "ok" : "FAILED");
+   ok &= (i > NmbVer);
+
+   // Both tables describe the same connectivity
+   res = ConnectivityChecksum32(LibParIdx, NmbEdg, 2, Edg32)
+      == ConnectivityChecksum64(LibParIdx, NmbEdg, 2, Edg64);
+   printf("connectivity checksums             : %s\n", res ? "ok" : "FAILED");
+   ok &= res;
+
+   // Dependencies set from either table
+   BeginDependency(LibParIdx, EdgTyp32, VerTyp);
+   AddDependencyTable32(LibParIdx, EdgTyp32, VerTyp, 2, Edg32);
+   EndDependency(LibParIdx, sta);
+
+   BeginDependency(LibParIdx, EdgTyp64, VerTyp);
+   AddDependencyTable64(LibParIdx, EdgTyp64, VerTyp, 2, Edg64);
+   EndDependency(LibParIdx, sta);
+
+   for(i=0;i<=NmbVer;i++)
+      Ver32[i] = Ver64[i] = 0;
+
+   LaunchParallel32(LibParIdx, EdgTyp32, VerTyp, (void *)EdgVer32, (void *)Edg32);
+   LaunchParallel64(LibParIdx, EdgTyp64, VerTyp, (void *)EdgVer64, (void *)Edg64);
+
+   res = ChkVer(1);
+   printf("dependency loops                   : %s\n", res ? "ok" : "FAILED");
+   ok &= res;
+
+   // Entity costs from either flavour of procedure
+   res = SetEntityCost32(LibParIdx, VerTyp, NULL, VerCst32, NULL)
+      && SetEntityCost64(LibParIdx, EdgTyp64, NULL, VerCst64, NULL);
+   printf("entity costs                       : %s\n", res ? "ok" : "FAILED");
+   ok &= res;
+
+   // A captured graph replays each launch with its own width
+   BeginCapture(LibParIdx);
+   LaunchParallel32(LibParIdx, EdgTyp32, VerTyp, (void *)EdgVer32, (void *)Edg32);
+   LaunchParallel64(LibParIdx, EdgTyp64, VerTyp, (void *)EdgVer64, (void *)Edg64);
+   GrfIdx = EndCapture(LibParIdx);
+
+   for(i=0;i<=NmbVer;i++)
+      Ver32[i] = Ver64[i] = 0;
+
+   ReplayGraph(LibParIdx, GrfIdx);
+   ReplayGraph(LibParIdx, GrfIdx);
+
+   res = ChkVer(2);
+   printf("captured graph                     : %s\n", res ? "ok" : "FAILED");
+   ok &= res;
+
+   StopParallel(LibParIdx);
+
+   free(Edg32);
+   free(Edg64);
+
+   puts(ok ? "index widths: ok" : "index widths: FAILED");
+
+   return(!ok);
+}
@@ -0,0 +1,241 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   SAVED DEPENDENCIES CHECK USING LPLib4                    */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       save the dependencies of a loop, reject a wrong key   */
+/*                      and a truncated file, load them back in another       */
+/*                      instance and check that both run the same schedule    */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 18 2026                                           */
+/*   Last modification: oct 18 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "lplib4.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbTet 400000
+#define NmbVer 80000
+#define NmbRun 3
+#define DepNam "saved_dependencies.dep"
+#define TrcNam "saved_dependencies_truncated.dep"
+
+
+/*----------------------------------------------------------------------------*/
+/* Structures' prototypes                                                     */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+   int      (*tet)[4], *own;
+   int64_t  cnf, *val;
+}ArgSct;
+
+
+/*----------------------------------------------------------------------------*/
+/* Scatter to the vertices with a non commutative update so that the result   */
+/* depends on the order in which each vertex' elements were run               */
+/*----------------------------------------------------------------------------*/
+
+void TetWrk(int BegIdx, int EndIdx, int PthIdx, ArgSct *arg)
+{
+   int i, j, v;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      for(j=0;j<4;j++)
+      {
+         v = arg->tet[i][j];
+
+         if(arg->own[v] && (arg->own[v] != PthIdx + 1))
+            arg->cnf++;
+
+         arg->own[v] = PthIdx + 1;
+         arg->val[v] = arg->val[v] * 3 + i;
+      }
+
+      for(j=0;j<4;j++)
+         arg->own[ arg->tet[i][j] ] = 0;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the loop and return a signature of the vertices' values                */
+/*----------------------------------------------------------------------------*/
+
+static int64_t RunLch(int64_t LibParIdx, int TetTyp, int VerTyp, ArgSct *arg)
+{
+   int      i, r;
+   int64_t  sig = 0;
+
+   memset(arg->val, 0, (NmbVer + 1) * sizeof(int64_t));
+
+   for(r=0;r<NmbRun;r++)
+      if(LaunchParallel(LibParIdx, TetTyp, VerTyp, (void *)TetWrk, (void *)arg) < 0)
+         return(0);
+
+   for(i=1;i<=NmbVer;i++)
+      sig += arg->val[i] * (i % 7 + 1);
+
+   return(sig);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Copy the first half of a file                                              */
+/*----------------------------------------------------------------------------*/
+
+static int TrcFil(char *InpNam, char *OutNam)
+{
+   long     siz;
+   char     *buf;
+   FILE     *inp, *out;
+
+   if(!(inp = fopen(InpNam, "rb")))
+      return(0);
+
+   fseek(inp, 0, SEEK_END);
+   siz = ftell(inp) / 2;
+   rewind(inp);
+
+   if(!(buf = malloc(siz)) || (fread(buf, 1, siz, inp) != (size_t)siz))
+   {
+      fclose(inp);
+      free(buf);
+      return(0);
+   }
+
+   fclose(inp);
+
+   if(!(out = fopen(OutNam, "wb")))
+   {
+      free(buf);
+      return(0);
+   }
+
+   fwrite(buf, 1, siz, out);
+   fclose(out);
+   free(buf);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* The main procedure reads the number of threads to launch, 8 by default     */
+/*----------------------------------------------------------------------------*/
+
+int main(int ArgCnt, char **ArgVec)
+{
+   int      i, j, k, NmbCpu = 8, TetTyp, VerTyp, NmbWrk, ok = 1;
+   int64_t  LibParIdx, sig[2];
+   uint64_t key;
+   float    sta[2][2];
+   ArgSct   arg;
+
+   // Read the command line arguments
+   if(ArgCnt > 1)
+      NmbCpu = atoi(*++ArgVec);
+
+   arg.tet = malloc((NmbTet + 1) * 4 * sizeof(int));
+   arg.own = calloc(NmbVer + 1, sizeof(int));
+   arg.val = calloc(NmbVer + 1, sizeof(int64_t));
+
+   if(!arg.tet || !arg.own || !arg.val)
+   {
+      puts("malloc failed");
+      exit(1);
+   }
+
+   // Elements sharing vertices with their neighbours in the numbering
+   srand(1);
+
+   for(i=1;i<=NmbTet;i++)
+      for(j=0;j<4;j++)
+         arg.tet[i][j] = (int)(((int64_t)i * NmbVer / NmbTet + j * 7 + rand() % 30) % NmbVer) + 1;
+
+   for(i=0;i<2;i++)
+   {
+      // Static scheduling makes both runs follow the saved groups
+      if(!(LibParIdx = InitParallel(NmbCpu)))
+      {
+         puts("Error initializing the LPLib4.");
+         exit(1);
+      }
+
+      SetExtendedAttributes(LibParIdx, StaticScheduling);
+
+      if(!(TetTyp = NewType(LibParIdx, NmbTet))
+      || !(VerTyp = NewType(LibParIdx, NmbVer)))
+      {
+         puts("Error while creating the types.");
+         exit(1);
+      }
+
+      key = ConnectivityChecksum(LibParIdx, NmbTet, 4, &arg.tet[0][0]);
+
+      if(!i)
+      {
+         // Build the dependencies and save them
+         BeginDependency(LibParIdx, TetTyp, VerTyp);
+
+         for(j=1;j<=NmbTet;j++)
+            for(k=0;k<4;k++)
+               AddDependency(LibParIdx, j, arg.tet[j][k]);
+
+         EndDependency(LibParIdx, sta[0]);
+
+         NmbWrk = SaveDependencies(LibParIdx, TetTyp, DepNam, key);
+         printf("saved %d blocks\n", NmbWrk);
+         ok &= NmbWrk > 0;
+      }
+      else
+      {
+         // A file saved for another mesh or cut short is rejected
+         ok &= !LoadDependencies(LibParIdx, TetTyp, DepNam, key + 1, sta[1]);
+         ok &= TrcFil(DepNam, TrcNam);
+         ok &= !LoadDependencies(LibParIdx, TetTyp, TrcNam, key, sta[1]);
+         remove(TrcNam);
+
+         // The right one is loaded after the failed attempts
+         NmbWrk = LoadDependencies(LibParIdx, TetTyp, DepNam, key, sta[1]);
+         printf("loaded %d blocks\n", NmbWrk);
+         ok &= (NmbWrk > 0) && (sta[0][0] == sta[1][0]) && (sta[0][1] == sta[1][1]);
+      }
+
+      arg.cnf = 0;
+      sig[i] = RunLch(LibParIdx, TetTyp, VerTyp, &arg);
+      printf("run %d: signature %lld, %lld conflicts\n",
+               i, (long long)sig[i], (long long)arg.cnf);
+      ok &= sig[i] && !arg.cnf;
+
+      StopParallel(LibParIdx);
+   }
+
+   remove(DepNam);
+
+   free(arg.tet);
+   free(arg.own);
+   free(arg.val);
+
+   ok &= (sig[0] == sig[1]);
+   puts(ok ? "saved dependencies: ok" : "saved dependencies: FAILED");
+
+   return(!ok);
+}
@@ -189,7 +189,11 @@ int main(int ArgCnt, char **ArgVec)
    printf("Input mesh          : version = %d, vertices = %d, tets = %d\n",
          msh.MshVer, msh.NmbVer, msh.NmbTet);
 
-   // Setup LP3 lib and datatypes
+   // Setup LP3 lib and datatypes, the threads' parameters being sized
+   // for MaxPth threads
+   if(!NmbCpu)
+      NmbCpu = MIN(GetNumberOfCores(), MaxPth);
+
    LibParIdx = InitParallel(NmbCpu);
    VerTyp = NewType(LibParIdx, msh.NmbVer);
    TetTyp = NewType(LibParIdx, msh.NmbTet);
@@ -0,0 +1,197 @@
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*               THREADS CONTENTION MICRO-BENCHMARK USING LPLib4              */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       measure the dynamic scheduler's cost with many tiny   */
+/*                      WP and the cost of user counters sharing cache lines  */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 18 2026                                           */
+/*   Last modification: oct 18 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "lplib4.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbLin 1000000
+#define NmbVer (NmbLin + 1)
+#define NmbLch 200
+#define NmbInc 10000000
+#define LinSiz 64
+
+
+/*----------------------------------------------------------------------------*/
+/* Structures' prototypes                                                     */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+   int64_t cpt;
+   char    pad[ LinSiz - sizeof(int64_t) ];
+}PadSct;
+
+typedef struct
+{
+   double   *vec;
+   int64_t  PakCpt[ MaxPth ];
+   PadSct   PadCpt[ MaxPth ];
+}ArgSct;
+
+
+/*----------------------------------------------------------------------------*/
+/* Tiny WP: line i scatters to its vertices i and i+1, the dependencies       */
+/* make each WP go through the dynamic scheduler and its shared mutex         */
+/*----------------------------------------------------------------------------*/
+
+void TinWrk(int BegIdx, int EndIdx, int PthIdx, ArgSct *arg)
+{
+   int i;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      arg->vec[ i - 1 ] += 1.;
+      arg->vec[ i ] += 1.;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Each thread increments its own counter, packed with the others:            */
+/* false sharing on the user's data, the library is not involved              */
+/*----------------------------------------------------------------------------*/
+
+void PakInc(int BegIdx, int EndIdx, int PthIdx, ArgSct *arg)
+{
+   int i;
+   volatile int64_t *cpt = &arg->PakCpt[ PthIdx ];
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      (*cpt)++;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Each thread increments its own counter, padded to a cache line             */
+/*----------------------------------------------------------------------------*/
+
+void PadInc(int BegIdx, int EndIdx, int PthIdx, ArgSct *arg)
+{
+   int i;
+   volatile int64_t *cpt = &arg->PadCpt[ PthIdx ].cpt;
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      (*cpt)++;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* The main procedure reads the number of threads to launch, 64 by default    */
+/*----------------------------------------------------------------------------*/
+
+int main(int ArgCnt, char **ArgVec)
+{
+   int      i, NmbCpu = 64, LinTyp, VerTyp, IncTyp;
+   int64_t  LibParIdx;
+   float    acc = 0., sta[2];
+   double   tim;
+   ArgSct   *arg;
+
+   // Read the command line arguments
+   if(ArgCnt > 1)
+      NmbCpu = atoi(*++ArgVec);
+
+   // The counters are sized for MaxPth threads
+   if(NmbCpu > MaxPth)
+      NmbCpu = MaxPth;
+
+   if(!(arg = calloc(1, sizeof(ArgSct))) || !(arg->vec = calloc(NmbVer, sizeof(double))))
+   {
+      puts("malloc failed");
+      exit(1);
+   }
+
+   if(!(LibParIdx = InitParallel(NmbCpu)))
+   {
+      puts("Error initializing the LPLib4.");
+      exit(1);
+   }
+
+   // Many small blocks per thread to stress the shared scheduler's state
+   SetExtendedAttributes(LibParIdx, SetSmallBlock, 256);
+
+   if(!(LinTyp = NewType(LibParIdx, NmbLin))
+   || !(VerTyp = NewType(LibParIdx, NmbVer))
+   || !(IncTyp = NewType(LibParIdx, NmbInc)))
+   {
+      puts("Error while creating the types.");
+      exit(1);
+   }
+
+   // Line i writes to vertices i-1 and i (the indices start at one)
+   BeginDependency(LibParIdx, LinTyp, VerTyp);
+
+   for(i=1;i<=NmbLin;i++)
+   {
+      AddDependency(LibParIdx, i, i);
+      AddDependency(LibParIdx, i, i+1);
+   }
+
+   EndDependency(LibParIdx, sta);
+
+   printf("%d threads\n", NmbCpu);
+
+   // Scheduling cost of tiny WP, the concurrency is the one measured
+   // by the dynamic scheduler
+   tim = GetWallClock();
+
+   for(i=0;i<NmbLch;i++)
+      acc += LaunchParallel(LibParIdx, LinTyp, VerTyp, (void *)TinWrk, (void *)arg);
+
+   tim = GetWallClock() - tim;
+   printf("tiny WP loops      : %g s, %g us per launch, concurrency %g\n",
+            tim, 1e6 * tim / NmbLch, acc / NmbLch);
+
+   // Every vertex but the two ends has been written by two lines per launch
+   for(i=1;i<NmbLin;i++)
+      if(arg->vec[i] != 2. * NmbLch)
+      {
+         printf("write conflict on vertex %d: %g\n", i + 1, arg->vec[i]);
+         exit(1);
+      }
+
+   // Per-thread counters sharing cache lines, this measures false sharing
+   // on the user's data, not the library's own contention
+   tim = GetWallClock();
+   LaunchParallel(LibParIdx, IncTyp, 0, (void *)PakInc, (void *)arg);
+   tim = GetWallClock() - tim;
+   printf("packed counters    : %g s\n", tim);
+
+   // Per-thread counters each on its own cache line
+   tim = GetWallClock();
+   LaunchParallel(LibParIdx, IncTyp, 0, (void *)PadInc, (void *)arg);
+   tim = GetWallClock() - tim;
+   printf("padded counters    : %g s\n", tim);
+
+   StopParallel(LibParIdx);
+
+   free(arg->vec);
+   free(arg);
+
+   return(0);
+}
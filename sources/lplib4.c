@@ -26,6 +26,10 @@
 #define _XOPEN_SOURCE 700
 #endif
 
+#ifdef __linux__
+#define _DEFAULT_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -38,6 +42,11 @@
 #include <time.h>
 #include "lplib4.h"
 
+// The library always works with 64 bit indices, the user's 32 bit ones
+// are converted by the entry points suffixed with the indices' width
+#undef  itg
+#define itg int64_t
+
 #ifdef _WIN32
 #include <windows.h>
 #include <sys/timeb.h>
@@ -46,6 +55,19 @@
 #include <sys/time.h>
 #endif
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef __MACH__
+#include <sys/types.h>
+#include <sys/sysctl.h>
+#endif
+
 #if defined(_WIN32) && !defined(NATIVE_WINDOWS)
 #include "winpthreads.h"
 #else
@@ -70,68 +92,142 @@
 #define POW(a)    ((a) * (a))
 
 #define MaxLibPar 10
-#define MaxTyp    100
+#define MaxTyp    LplMaxTyp
 #define DefSmlBlk 64
 #define DefDepBlk 256
 #define MaxTotPip 65536
 #define MaxPipDep 100
+#define MaxDepTyp 8
+#define DepFilVer 1
+#define DepHdrSiz (11 + 4 * MaxDepTyp)
 #define MaxHsh    10
 #define HshBit    16
 #define MaxVarArg 20
 #define MaxF77Arg 20
 #define WrkPerGrp 8
+#define GrpScnWin 64
 #define BigMemSiz 100000000ULL
+#define MaxPol    256
+#define NmbWakItr 4
+#define MaxTun    256
+#define MaxTunItl 64
+#define MaxCacIdx 8
+#define MinSmlBlk 8
+#define MinDepBlk 32
+#define NmbAdpLvl 2
+#define MaxGrf    64
 #define MAXEDG    1000
 #define MAXITR    21
 #define HILMOD    0
 #define OCTMOD    1
 #define RNDMOD    2
+#define CchLinSiz 64
+#define MaxItlBlk 256
+#define WakTreFan 4
+#define TreWakPth 32
+#define HugPagSiz 2097152
+#define RegPagSiz 4096
+#define ArnChkSiz 65536
+#define MinBwdSiz 1048576
+#define PatBlkSiz 8192
+
+// Start a structure's field on a new cache line
+#if ( __STDC_VERSION__ > 201100L )
+#define LplAln    _Alignas(CchLinSiz)
+#elif defined(__GNUC__)
+#define LplAln    __attribute__((aligned(CchLinSiz)))
+#else
+#define LplAln
+#endif
 
 enum {HilMod=0, OctMod, RndMod, IniMod, TopMod};
+enum TunPhs {TunPth, TunItl, TunSrt, TunSml, TunDep, TunEnd};
+enum HugTyp {HugMal, HugExp, HugTrn};
 enum ParCmd {  RunBigWrk, RunSmlWrk, RunDetWrk, RunColWrk,
-               ClrMem, CpyMem, RunGrnWrk, EndPth };
+               RunRplWrk, RunGrfWrk, ClrMem, CpyMem, SetMem, RunGrnWrk, EndPth };
 
 
 /*----------------------------------------------------------------------------*/
 /* Structures' prototypes                                                     */
 /*----------------------------------------------------------------------------*/
 
+// Small WP only keep what the schedulers read, in a single cache line,
+// the fields NexWrk goes through first
 typedef struct WrkSct
 {
-   itg               BegIdx, EndIdx, ItlTab[ MaxPth ][2];
-   int               NmbDep, *DepWrdTab, GrpIdx, rnd, GrnIdx;
-   double            RunTim;
+   itg               BegIdx, EndIdx;
+   int               NmbDep, *DepWrdTab;
    struct WrkSct     *pre, *nex;
+   int               PthIdx, LstIdx, NodIdx;
+   float             pri;
 }WrkSct;
 
+// Big WP are only run by their own thread and are the ones to use
+// interleaving, their ItlTab points to a table of MaxItlBlk ranges
+typedef struct
+{
+   itg               (*ItlTab)[2];
+   double            RunTim;
+}BigSct;
+
+typedef struct
+{
+   itg               BegIdx, EndIdx;
+   int               NmbDep, *DepWrdTab, son[2], fat, act;
+   double            RunTim;
+}NodSct;
+
+// The threads' tables are sized after the number of threads
+// and allocated along with the group by NewGrp
 typedef struct GrpSct
 {
-   int               idx, NmbSmlWrk[ MaxPth ];
-   WrkSct            *SmlWrkTab[ MaxPth ][ WrkPerGrp ];
+   int               idx, *NmbSmlWrk, *WaiTab;
+   WrkSct            *(*SmlWrkTab)[ WrkPerGrp ];
    struct GrpSct     *nex;
 }GrpSct;
 
 typedef struct
 {
-   itg               NmbLin, MaxNmbLin;
-   int               NmbSmlWrk, SmlWrkSiz, DepWrkSiz, NmbGrp;
-   int               NmbDepWrd, *DepWrdMat, *RunDepTab;
+   itg               NmbLin;
+   int               NmbSmlWrk, SmlWrkSiz, DepWrkSiz, NmbGrp, NmbItlBlk;
+   int               MaxSmlWrk, MaxDepRow, DepWrdStr;
+   int               NmbDepWrd, *DepWrdMat, *RunDepTab, SrtFlg, SrtUpd, SmlLvl, DepLvl;
+   int               AdpLvl, AdpUpd, NmbLef, NmbNod, RooNod, NmbTgt, *NodDepMat;
+   int               CstShf, NmbAff, MaxAff, NmbSlt, *AffSlt;
+   int               RplTyp, RplRec, RplEpo, NmbRpl, *RplSeq, *RplOff, *RplWrk;
+   int               *RplPreOff, *RplPreTab, *RplDon;
+   int               OrdDep, OrdUpd, OrdHed, OrdTal, *OrdPre, *OrdCnt, *OrdQue;
+   int               *OrdSucOff, *OrdSucTab, CrtPth, DepFus, DepTot, DepMax;
+   int               NmbDepTyp, DepTypIdx[ MaxDepTyp ], DepBitOff[ MaxDepTyp ];
+   int               DepBlkSiz[ MaxDepTyp ], DepBitLst[ MaxDepTyp ];
+   float             RplAcc, *PriTab, *PriBit;
+   itg               CstLin, NmbLok;
+   size_t            EntSiz, RplSiz, OrdSiz;
+   double            *CstSum, SmlCst, MaxCst;
 #if ( __STDC_VERSION__ > 201100L )
    _Atomic int       *AtoLok;
 #endif
-   WrkSct            *SmlWrkTab, *BigWrkTab;
+   WrkSct            *SmlWrkTab, **AffTab;
+   BigSct            *BigWrkTab;
+   NodSct            *NodTab;
    GrpSct            *NexGrp;
 }TypSct;
 
+// Each thread's structure starts on its own cache lines, so that the WP
+// handed to a thread, its stats and its progress do not share a line
+// with those of the other threads
 typedef struct
 {
-   int               idx, NmbDetWrk;
+   WrkSct            LplAln *wrk;
+   WrkSct            *AffWrk;
+   BigSct            *big;
+   int               idx, DonGrp, NmbSon, SonDon;
+   float             sta[2];
+   pthread_mutex_t   mtx;
+   pthread_cond_t    cnd;
    char              *ClrAdr, *DstAdr, *SrcAdr;
    size_t            StkSiz, CpyMemSiz, ClrMemSiz;
    void *            *UsrStk;
-   WrkSct            *wrk, **DetWrkTab;
-   pthread_mutex_t   mtx;
-   pthread_cond_t    cnd;
    pthread_t         pth;
    pthread_attr_t    atr;
    struct ParSct     *par;
@@ -140,12 +236,15 @@ typedef struct
 typedef struct PipSct
 {
    int               idx, NmbVarArg, NmbDep, DepTab[ MaxPipDep ], BegIdx, EndIdx, GrnIdx;
+   int               UsrPri;
+   float             pri;
    void              *prc, *arg, *VarArgTab[ MaxVarArg ];
    size_t            StkSiz;
    void              *UsrStk;
    pthread_attr_t    atr;
    pthread_t         pth;
    struct ParSct     *par;
+   struct PipSct     *pre, *nex;
 }PipSct;
 
 typedef struct
@@ -156,26 +255,156 @@ typedef struct
    struct ParSct     *par;
 }GrnSct;
 
+typedef struct
+{
+   int               TypIdx, TypIdx2, NmbPth, UsrCst;
+   itg               NmbLin;
+   void              *prc;
+   double            EntTim;
+}PolSct;
+
+typedef struct
+{
+   int               TypIdx1, TypIdx2, rnk, phs, cnt, NmbTry;
+   int               NmbPth, NmbItl, SrtFlg, SmlLvl, DepLvl;
+   int               CurPth, CurItl, CurSrt;
+   int               SnpNmbSml, SnpSmlSiz, SnpNmbWrd, SnpDepSiz, *SnpDepMat;
+   itg               NmbLin1, NmbLin2;
+   size_t            SnpSiz;
+   void              *prc;
+   double            tim, BstTim;
+   WrkSct            *SnpWrkTab;
+}TunSct;
+
+typedef struct
+{
+   TypSct            *typ;
+   int               *WrkBitOff, *WrkBitTab;
+}GrpArgSct;
+
+typedef struct
+{
+   TypSct            *typ;
+   void              *tab;
+   itg               NmbLin2;
+   int               IdxWid, NmbPer, BitOff, BitLst, BlkSiz, *tot, *max;
+}DepArgSct;
+
+typedef struct
+{
+   void              *tab;
+   int               IdxWid, NmbPer;
+   uint64_t          *sum;
+}ChkSct;
+
+typedef struct
+{
+   char              *adr;
+   size_t            EntSiz, TotSiz, PagSiz, NmbPth;
+}TchSct;
+
+// Header of an arena's block, on its own cache line: the link of the free
+// list and the pipe thread that last ran on a stack block and must be
+// joined before the stack is reused
+typedef struct BlkSct
+{
+   struct BlkSct     *nex;
+   pthread_t         pth;
+   int               JoiFlg;
+}BlkSct;
+
+// Fixed size blocks recycled through a free list and carved out of chunks
+typedef struct
+{
+   pthread_mutex_t   mtx;
+   size_t            BlkSiz, AlcSiz;
+   int               ClrFlg, BlkPerChk;
+   BlkSct            *FreBlk;
+   void              *NexChk;
+}ArnSct;
+
+// Header stored at the beginning of LplAlloc's areas, on its own cache line
+typedef struct
+{
+   int               typ;
+   size_t            MapSiz;
+}HugSct;
+
+typedef struct
+{
+   int               cmd, TypIdx1, TypIdx2, NmbVarArg, PrcWid;
+   void              *prc, *arg, *VarArgTab[ MaxVarArg ];
+   char              *ClrAdr;
+   size_t            ClrSiz;
+}CapSct;
+
+typedef struct
+{
+   int               use, NmbCap, MaxCap;
+   CapSct            *CapTab;
+}GrfSct;
+
+typedef struct
+{
+   float             *tab, (*prc)(itg, void *);
+   int               PrcWid;
+   void              *arg;
+   double            *sum, MaxCst, *off, *max;
+}CstSct;
+
 typedef struct ParSct
 {
-   int               NmbCpu, WrkCpt, NmbPip, PenPip, RunPip, NmbTyp, DynSch;
-   int               req, cmd, *PipWrd, SizMul, NmbVarArg, NmbDep;
-   int               WrkSizSrt, NmbItlBlk, ItlBlkSiz, BufMax, BufCpt;
+   // Settings and launch parameters: only written by the main thread
+   // between two launches and read by the workers
+   int               NmbCpu, NmbTyp, DynSch, cmd, SizMul, NmbVarArg;
+   int               WrkSizSrt, NmbItlBlk, ItlBlkSiz, BufMax;
    int               NmbSmlBlk, NmbDepBlk, NmbColGrn, GrnNxt, GrnDon, clk;
    int               NmbGrnWrk, GrnWrkSiz, DepGrnSiz, NmbCol, NmbGrn, *GrnMat;
-   int               (*GrnTab[ LplMax ])[2], (*ColTab)[2], CurCol;
+   int               (*GrnTab[ LplMax ])[2], (*ColTab)[2];
    int               NmbDepWrd, *RunDepTab, *ColCpt, *GrnCol;
    int               NmbGrnWrd, *GrnWrdMat, *RunGrnTab, TypIdx[ LplMax ];
-   size_t            StkSiz;
+   int               LchPol, NmbPol, NmbTem, AutTun, TunItr, NmbTun, LlcPth;
+   int               AffSch, RplSch, RplFrc, OrdDep, CrtPth, LodGrp, MemStr, AdpTre;
+   int               CapGrf, GrfBeg, GrfEnd, NmbWak, TreWak, PrcWid, *PthPag, *PthCnt;
+   itg               (*PthBlk)[2];
+   uint64_t          *PthSum;
+   double            *PthCst;
+   size_t            StkSiz, L1Siz, L2Siz, LlcSiz, PatSiz;
+   double            WakTim, MemBwd[2];
    void              *lmb, *VarArgTab[ MaxVarArg ];
-   float             sta[2];
    void              (*prc)(itg, itg, int, void *), *arg;
-   pthread_cond_t    ParCnd, PipCnd;
-   pthread_mutex_t   ParMtx, PipMtx;
-   pthread_t         PipPth;
    PthSct            *PthTab;
    TypSct            *TypTab, *CurTyp, *DepTyp, *typ1, *typ2;
-   WrkSct            *NexWrk, *BufWrk[ MaxPth / 4 ], *GrnWrkTab;
+   WrkSct            *GrnWrkTab, **PthWrk;
+   BigSct            *TemWrkTab;
+   PolSct            PolTab[ MaxPol ];
+   TunSct            TunTab[ MaxTun ];
+   GrfSct            GrfTab[ MaxGrf ], *CurGrf;
+   LplMemSct         MemPek, MemCur;
+   size_t            MemTab[ MaxTyp + 1 ][ LplMemMax ];
+
+   // Scheduler's state, updated under ParMtx by every thread after each WP
+   pthread_mutex_t   LplAln ParMtx;
+   pthread_cond_t    ParCnd;
+   int               WrkCpt, req, NmbDep, BufCpt, CurCol;
+   WrkSct            *NexWrk, **BufWrk;
+
+   // Pipelines' state, updated under PipMtx
+   pthread_mutex_t   LplAln PipMtx;
+   pthread_cond_t    PipCnd;
+   int               NmbPip, PenPip, RunPip, *PipWrd;
+   pthread_t         PipPth;
+   PipSct            **PipTab, *WaiPip;
+
+   // Static groups, replay and graph barriers' state, updated under GrpMtx
+   pthread_mutex_t   LplAln GrpMtx;
+   pthread_cond_t    GrpCnd;
+   int               RplWai, BarCnt, BarGen;
+
+   // Arenas of pipes, pipes' stacks and groups, each one under its own mutex
+   ArnSct            LplAln PipArn;
+   ArnSct            LplAln StkArn;
+   ArnSct            LplAln GrpArn;
 }ParSct;
 
 typedef struct
@@ -278,15 +507,135 @@ static void       SubWrd         (int, int *, int *);
 static void       ClrWrd         (int, int *);
 static void       CpyWrd         (int, int *, int *);
 int               CmpWrk         (const void *, const void *);
+static int        CmpBeg         (const void *, const void *);
+static int        CmpPtr         (const void *, const void *);
+static int        CntBit         (int, int *);
+static int        HlvSml         (TypSct *);
+static int        HlvDep         (TypSct *);
 static void      *PipHdl         (void *);
 static void      *PthHdl         (void *);
+static void       RunBig         (ParSct *, PthSct *);
+static void       RunDet         (ParSct *, PthSct *);
+static void       RunRpl         (ParSct *, PthSct *);
 static WrkSct    *NexWrk         (ParSct *, int);
+static WrkSct    *NexBuf         (ParSct *, int);
 static WrkSct    *NexGrn         (ParSct *, int);
+static int        SetAffLst      (ParSct *, TypSct *);
+static WrkSct    *NexAff         (ParSct *, int);
+static WrkSct    *TakAff         (ParSct *, WrkSct *, int);
+static int        AlcRpl         (ParSct *, TypSct *);
+static int        SetRpl         (ParSct *, TypSct *);
+static void       FreRpl         (ParSct *, TypSct *);
+static void       ChgWrk         (TypSct *);
+static int        SetOrd         (ParSct *, TypSct *);
+static void       RstOrd         (TypSct *);
+static WrkSct    *NexOrd         (ParSct *, int);
+static int        SetOrdGrp      (ParSct *, TypSct *);
+static void       FreOrd         (ParSct *, TypSct *);
+static void       PshOrd         (TypSct *, int);
+static int        PopOrd         (TypSct *);
+static void       SetPri         (TypSct *);
+static void       RaiPip         (ParSct *, PipSct *, float);
+static int        ChkPip         (ParSct *, PipSct *);
+static void       AddCap         (ParSct *, int, int, int, void *, void *, void *, size_t);
+static int        ResCap         (ParSct *, CapSct *);
+static void       RunCap         (ParSct *, CapSct *);
+static void       SetCap         (ParSct *, CapSct *);
+static void       RunGrf         (ParSct *, PthSct *);
+static void       GrfBar         (ParSct *, CapSct *);
+static float      LchGrn         (ParSct *, int, int, void *, void *);
+static float      GrnVar         (ParSct *, int, int, void *, int, va_list);
 static void       CalVarArgPip   (PipSct *, void *);
 static void       CalVarArgPrc   (itg, itg, int, ParSct *);
+static void       CalPrc         (ParSct *, itg, itg, int);
 static int64_t    IniPar         (int, size_t, void *);
+static float      LchWid         (ParSct *, int, int, int, void *, void *);
+static float      LchVar         (ParSct *, int, int, int, void *, int, va_list);
+static float      LchPar         (ParSct *, int, int, void *, void *);
+static float      PolLch         (ParSct *, int, int, void *, void *);
+static PolSct    *GetPol         (ParSct *, int, int, void *);
+static int        SetPolPth      (ParSct *, double);
+static void       TemLch         (ParSct *, TypSct *, itg, itg, int, int);
+static double     MesWakTim      (ParSct *);
+static void       GetCacSiz      (ParSct *);
+static int        SetSmlWrk      (ParSct *, TypSct *, int);
+static int        NewNod         (ParSct *, TypSct *);
+static void       SetAdpWrk      (TypSct *);
+static void       AddAdpWrk      (TypSct *, int, int *);
+static void       UpdNod         (TypSct *);
+static int        AdpNod         (TypSct *, int, double);
+static int        SetNodBit      (TypSct *, int, int);
+static void       RstLef         (ParSct *, TypSct *);
+static void       FreNod         (ParSct *, TypSct *);
+static int        SetCst         (ParSct *, int, int, float *, void *, void *);
+static void       CstSumPss      (itg, itg, int, void *);
+static void       CstOffPss      (itg, itg, int, void *);
+static itg        CstIdx         (TypSct *, double, double, double);
+static int        GetSmlIdx      (TypSct *, itg);
+static float      TunLch         (ParSct *, int, int, void *, void *);
+static float      RunTun         (ParSct *, int, int, void *, void *, int, int);
+static TunSct    *GetTun         (ParSct *, int, int, void *);
+static void       NxtTun         (ParSct *, TunSct *, double);
+static int        NxtCnd         (ParSct *, TunSct *);
+static void       RstCnd         (ParSct *, TunSct *);
+static void       SetTunTyp      (ParSct *, TunSct *);
+static void       SrtSmlWrk      (TypSct *, int);
+static void       IdxSmlWrk      (TypSct *);
+static int        SnpTyp         (ParSct *, TunSct *);
+static void       RstSnp         (ParSct *, TunSct *);
+static void       FreSnp         (ParSct *, TunSct *);
+static int        RszSml         (ParSct *, TypSct *, itg);
+static int        RszDep         (ParSct *, TypSct *);
+static void       DrpSnp         (ParSct *, TypSct *);
 static void       SetItlBlk      (ParSct *, TypSct *);
+static void       SetBigWrk      (ParSct *, TypSct *);
 static int        SetGrp         (ParSct *, TypSct *);
+static int        SetGrpWai      (ParSct *, TypSct *);
+static void       SetWrkBit      (itg, itg, int, void *);
+static void       AddFst         (ParSct *, int, int, void *, int, void *);
+static int        AddTab         (ParSct *, int, int, int, int, void *);
+static void       AddDepTab      (itg, itg, int, void *);
+static void       UpdFst         (ParSct *, int, int, int, void *, int, int, void *);
+static itg        GetIdx         (void *, int, itg);
+static void       SetDepSiz      (ParSct *, TypSct *, int *, int *);
+static int        GetDepTyp      (TypSct *, int);
+static void       FreDep         (ParSct *, TypSct *);
+static int        GetDepBit      (TypSct *, int, itg);
+static int        CntDepBit      (ParSct *, TypSct *);
+static uint64_t   ChkSum         (ParSct *, int, itg, int, void *);
+static void       ChkTab         (itg, itg, int, void *);
+static uint64_t   MixHsh         (uint64_t);
+static int        LodGrp         (ParSct *, TypSct *, FILE *, int);
+static void       FreGrp         (ParSct *, TypSct *);
+static BigSct    *NewItlWrk      (ParSct *, int);
+static void       FreItlWrk      (ParSct *, BigSct *);
+static int        GetGrnIdx      (ParSct *, WrkSct *);
+static GrpSct    *NewGrp         (ParSct *);
+static void       RunTre         (ParSct *, int);
+static void       WakSon         (ParSct *, PthSct *);
+static void       EndTre         (ParSct *, PthSct *);
+static int        GetSon         (ParSct *, int, int *);
+static int        GetFat         (ParSct *, int);
+static void      *AlcAln         (void *, int64_t);
+static void       FreAln         (void *, void *);
+static void       IniArn         (ArnSct *, size_t, int);
+static void      *GetBlk         (ParSct *, ArnSct *);
+static void       PutBlk         (ArnSct *, void *, int);
+static void       FreArn         (ParSct *, ArnSct *);
+static void       GetMem         (ParSct *, int, size_t *);
+static size_t     HugSiz         (void *, size_t);
+static void       UpdMem         (ParSct *, int);
+static float      SumSta         (ParSct *);
+static int        ParMem         (ParSct *, int, size_t);
+static void       SetMemBwd      (ParSct *, int, size_t, double);
+static size_t     SlcOff         (ParSct *, char *, size_t, size_t, int);
+static void       ClrKer         (char *, size_t, int);
+static void       CpyKer         (char *, char *, size_t, int);
+static void       SetKer         (char *, size_t, char *, size_t, int);
+static void      *AlcHug         (void *, int64_t, int);
+static void       FreHug         (void *, void *);
+static void       TchBlk         (itg, itg, int, void *);
+static void       TchPag         (itg, itg, int, void *);
 static void      *LPL_malloc     (void *, int64_t);
 static void      *LPL_calloc     (void *, int64_t, int64_t);
 static void       LPL_free       (void *, void *);
@@ -336,6 +685,7 @@ int64_t InitParallelAttr(int NmbCpu, size_t StkSiz, void *lmb)
 static int64_t IniPar(int NmbCpu, size_t StkSiz, void *lmb)
 {
    int i;
+   char *FilNam;
    int64_t ParIdx;
    ParSct *par;
    PthSct *pth;
@@ -349,17 +699,14 @@ static int64_t IniPar(int NmbCpu, size_t StkSiz, void *lmb)
          return(0);
    }
 
-   if(NmbCpu > MaxPth)
-      NmbCpu = MaxPth;
-
    // Allocate and build main parallel structure
-   if(!(par = LPL_calloc(lmb, 1, sizeof(ParSct))))
+   if(!(par = AlcAln(lmb, sizeof(ParSct))))
       return(0);
 
    // Pass along a potential libMemBlocks structure
    par->lmb = lmb;
 
-   if(!(par->PthTab = LPL_calloc(par->lmb, NmbCpu, sizeof(PthSct))))
+   if(!(par->PthTab = AlcAln(par->lmb, NmbCpu * sizeof(PthSct))))
       return(0);
 
    if(!(par->TypTab = LPL_calloc(par->lmb, (MaxTyp + 1), sizeof(TypSct))))
@@ -368,7 +715,31 @@ static int64_t IniPar(int NmbCpu, size_t StkSiz, void *lmb)
    if(!(par->PipWrd = LPL_calloc(par->lmb, MaxTotPip/32, sizeof(int))))
       return(0);
 
-   par->NmbCpu = NmbCpu;
+   if(!(par->TemWrkTab = NewItlWrk(par, NmbCpu)))
+      return(0);
+
+   // Per-thread scratch tables used by the scheduler
+   if(!(par->PthBlk = LPL_malloc(par->lmb, NmbCpu * 2 * sizeof(itg))))
+      return(0);
+
+   if(!(par->PthPag = LPL_malloc(par->lmb, NmbCpu * sizeof(int))))
+      return(0);
+
+   if(!(par->PthWrk = LPL_malloc(par->lmb, NmbCpu * sizeof(WrkSct *))))
+      return(0);
+
+   // and by the team loops summing the threads' counts, hashes and costs
+   if(!(par->PthCnt = LPL_malloc(par->lmb, NmbCpu * 2 * sizeof(int))))
+      return(0);
+
+   if(!(par->PthSum = LPL_malloc(par->lmb, NmbCpu * sizeof(uint64_t))))
+      return(0);
+
+   if(!(par->PthCst = LPL_malloc(par->lmb, NmbCpu * 2 * sizeof(double))))
+      return(0);
+
+   par->NmbCpu = par->NmbTem = NmbCpu;
+   par->PrcWid = LplLng;
    par->WrkCpt = par->NmbPip = par->PenPip = par->RunPip = 0;
    par->SizMul = 2;
    par->StkSiz = StkSiz;
@@ -378,16 +749,30 @@ static int64_t IniPar(int NmbCpu, size_t StkSiz, void *lmb)
    par->NmbSmlBlk = DefSmlBlk;
    par->NmbDepBlk = DefDepBlk;
 
+   // Get the caches' sizes to set the default blocks sizes
+   GetCacSiz(par);
+
    // Set the size of WP buffer
    if(NmbCpu >= 4)
       par->BufMax = NmbCpu / 4;
    else
       par->BufMax = 1;
 
+   if(!(par->BufWrk = LPL_malloc(par->lmb, par->BufMax * sizeof(WrkSct *))))
+      return(0);
+
    pthread_mutex_init(&par->ParMtx, NULL);
    pthread_mutex_init(&par->PipMtx, NULL);
+   pthread_mutex_init(&par->GrpMtx, NULL);
    pthread_cond_init(&par->ParCnd, NULL);
    pthread_cond_init(&par->PipCnd, NULL);
+   pthread_cond_init(&par->GrpCnd, NULL);
+
+   // Pipes and groups are cleared like their former calloc
+   IniArn(&par->PipArn, sizeof(PipSct), 1);
+   IniArn(&par->StkArn, StkSiz, 0);
+   IniArn(&par->GrpArn, sizeof(GrpSct) + NmbCpu
+            * (WrkPerGrp * sizeof(WrkSct *) + sizeof(int)), 1);
 
    // Launch pthreads
    for(i=0;i<par->NmbCpu;i++)
@@ -427,7 +812,15 @@ static int64_t IniPar(int NmbCpu, size_t StkSiz, void *lmb)
 
    pthread_mutex_unlock(&par->ParMtx);
 
+   // Measure the cost of waking up the pool for the launch policy
+   par->WakTim = MesWakTim(par);
+
    ParIdx = (int64_t)par;
+   UpdMem(par, 0);
+
+   // Reload the settings found by a previous auto-tuning run
+   if((FilNam = getenv("LPLIB_TUNING_FILE")))
+      LoadTuning(ParIdx, FilNam);
 
    return(ParIdx);
 }
@@ -440,6 +833,7 @@ static int64_t IniPar(int NmbCpu, size_t StkSiz, void *lmb)
 void StopParallel(int64_t ParIdx)
 {
    int i;
+   char *FilNam;
    PthSct *pth;
    ParSct *par = (ParSct *)ParIdx;
 
@@ -447,6 +841,10 @@ void StopParallel(int64_t ParIdx)
    if(!ParIdx)
       return;
 
+   // Store the auto-tuned settings for the next runs
+   if(par->AutTun && (FilNam = getenv("LPLIB_TUNING_FILE")))
+      SaveTuning(ParIdx, FilNam);
+
    // Send stop to all threads
    pthread_mutex_lock(&par->ParMtx);
    par->cmd = EndPth;
@@ -467,6 +865,8 @@ void StopParallel(int64_t ParIdx)
 
    pthread_mutex_destroy(&par->ParMtx);
    pthread_cond_destroy(&par->ParCnd);
+   pthread_mutex_destroy(&par->GrpMtx);
+   pthread_cond_destroy(&par->GrpCnd);
 
    WaitPipeline(ParIdx);
 
@@ -478,10 +878,29 @@ void StopParallel(int64_t ParIdx)
       if(par->TypTab[i].NmbLin)
          FreeType(ParIdx, i);
 
-   LPL_free(par->lmb, par->PthTab);
+   par->CapGrf = 0;
+
+   for(i=1;i<=MaxGrf;i++)
+      FreeGraph(ParIdx, i);
+
+   FreArn(par, &par->PipArn);
+   FreArn(par, &par->StkArn);
+   FreArn(par, &par->GrpArn);
+   FreAln(par->lmb, par->PthTab);
    LPL_free(par->lmb, par->TypTab);
    LPL_free(par->lmb, par->PipWrd);
-   free(par);
+
+   if(par->PipTab)
+      LPL_free(par->lmb, par->PipTab);
+   FreItlWrk(par, par->TemWrkTab);
+   LPL_free(par->lmb, par->PthBlk);
+   LPL_free(par->lmb, par->PthPag);
+   LPL_free(par->lmb, par->PthWrk);
+   LPL_free(par->lmb, par->PthCnt);
+   LPL_free(par->lmb, par->PthSum);
+   LPL_free(par->lmb, par->PthCst);
+   LPL_free(par->lmb, par->BufWrk);
+   FreAln(par->lmb, par);
 }
 
 
@@ -511,7 +930,7 @@ int GetNumberOfCores()
 
 int SetExtendedAttributes(int64_t ParIdx, ...)
 {
-   int NmbArg = 0, ArgCod, ArgVal;
+   int i, NmbArg = 0, ArgCod, ArgVal;
    ParSct *par = (ParSct *)ParIdx;
    va_list ArgLst;
 
@@ -533,7 +952,7 @@ int SetExtendedAttributes(int64_t ParIdx, ...)
 
          if(ArgVal > 0)
          {
-            par->NmbItlBlk = ArgVal;
+            par->NmbItlBlk = MIN(ArgVal, MaxItlBlk);
             par->ItlBlkSiz = 0;
             NmbArg++;
          }
@@ -615,6 +1034,110 @@ int SetExtendedAttributes(int64_t ParIdx, ...)
          par->clk = 0;
          NmbArg++;
       }break;
+
+      // Run small loops inline or on a subset of threads
+      case EnableLaunchPolicy :
+      {
+         par->LchPol = 1;
+         NmbArg++;
+      }break;
+
+      case DisableLaunchPolicy :
+      {
+         par->LchPol = 0;
+         NmbArg++;
+      }break;
+
+      // Explore the best settings of each procedure during its first launches
+      case EnableAutoTuning :
+      {
+         ArgVal = va_arg(ArgLst, int);
+
+         if(ArgVal > 0)
+         {
+            par->AutTun = 1;
+            par->TunItr = ArgVal;
+            NmbArg++;
+         }
+      }break;
+
+      case DisableAutoTuning :
+      {
+         par->AutTun = 0;
+         NmbArg++;
+      }break;
+
+      // Keep threads on the same and neighbouring WP of dependency loops
+      case EnableCacheAffinity :
+      {
+         par->AffSch = 1;
+         NmbArg++;
+      }break;
+
+      case DisableCacheAffinity :
+      {
+         par->AffSch = 0;
+         NmbArg++;
+      }break;
+
+      // Record the dynamic schedule of each dependency loop and replay it,
+      // former records are dropped so that enabling it again starts afresh
+      case EnableScheduleReplay :
+      {
+         par->RplSch = 1;
+
+         for(i=1;i<=MaxTyp;i++)
+            par->TypTab[i].RplTyp = 0;
+
+         NmbArg++;
+      }break;
+
+      case DisableScheduleReplay :
+      {
+         par->RplSch = 0;
+         NmbArg++;
+      }break;
+
+      // Conflicting WP of the next dependency loops will run in index order
+      case EnableOrderedDependencies :
+      {
+         par->OrdDep = 1;
+         NmbArg++;
+      }break;
+
+      case DisableOrderedDependencies :
+      {
+         par->OrdDep = 0;
+         NmbArg++;
+      }break;
+
+      // Critical work first: WP and pipes get the priority
+      // of the longest chain of work that depends on them
+      case EnableCriticalPath :
+      {
+         par->CrtPth = 1;
+         NmbArg++;
+      }break;
+
+      case DisableCriticalPath :
+      {
+         par->CrtPth = 0;
+         NmbArg++;
+      }break;
+
+      // Small WP of the next dependency loops are split
+      // and merged from their run times through a tree
+      case EnableAdaptiveTree :
+      {
+         par->AdpTre = 1;
+         NmbArg++;
+      }break;
+
+      case DisableAdaptiveTree :
+      {
+         par->AdpTre = 0;
+         NmbArg++;
+      }break;
    }
 
    va_end(ArgLst);
@@ -623,22 +1146,39 @@ int SetExtendedAttributes(int64_t ParIdx, ...)
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* Launch the loop prc, taking 32 bit indices, on typ1 depending on typ2      */
+/*----------------------------------------------------------------------------*/
+
+float LaunchParallel32(int64_t ParIdx, int TypIdx1, int TypIdx2,
+                       void *prc, void *PtrArg )
+{
+   return(LchWid((ParSct *)ParIdx, LplInt, TypIdx1, TypIdx2, prc, PtrArg));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Launch the loop prc, taking 64 bit indices, on typ1 depending on typ2      */
+/*----------------------------------------------------------------------------*/
+
+float LaunchParallel64(int64_t ParIdx, int TypIdx1, int TypIdx2,
+                       void *prc, void *PtrArg )
+{
+   return(LchWid((ParSct *)ParIdx, LplLng, TypIdx1, TypIdx2, prc, PtrArg));
+}
+
+
 /*----------------------------------------------------------------------------*/
 /* Launch the loop prc on typ1 element depending on typ2                      */
 /*----------------------------------------------------------------------------*/
 
-float LaunchParallel(int64_t ParIdx, int TypIdx1, int TypIdx2,
-                     void *prc, void *PtrArg )
+static float LchWid(ParSct *par, int wid, int TypIdx1, int TypIdx2,
+                    void *prc, void *PtrArg )
 {
-   int      i;
-   float    acc = 0.;
-   PthSct   *pth;
-   ParSct   *par = (ParSct *)ParIdx;
-   TypSct   *typ1, *typ2 = NULL;
-   GrpSct   *grp;
+   float acc;
 
    // Get and check lib parallel instance
-   if(!ParIdx)
+   if(!par)
       return(-1.);
 
    // Check bounds
@@ -648,49 +1188,120 @@ float LaunchParallel(int64_t ParIdx, int TypIdx1, int TypIdx2,
       return(-1.);
    }
 
+   // 32 bit indices cannot address the lines of a bigger type
+   if( (wid == LplInt) && (par->TypTab[ TypIdx1 ].NmbLin > INT32_MAX) )
+      return(-1.);
+
+   // The procedure is called with the indices' width it was launched with
+   par->PrcWid = wid;
+
+   // Record the launch into the graph being captured
+   if(par->CapGrf)
+      AddCap(par, TypIdx2 ? RunSmlWrk : RunBigWrk, TypIdx1, TypIdx2, prc, PtrArg, NULL, 0);
+
+   // Explore or apply the tuned settings of this procedure
+   if(par->AutTun || par->NmbTun)
+      acc = TunLch(par, TypIdx1, TypIdx2, prc, PtrArg);
+
+   // Let the launch policy run small loops inline or on a partial team
+   else if(par->LchPol)
+      acc = PolLch(par, TypIdx1, TypIdx2, prc, PtrArg);
+
+   else
+      acc = LchPar(par, TypIdx1, TypIdx2, prc, PtrArg);
+
+   par->PrcWid = LplLng;
+
+   return(acc);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Wake up the whole pool of threads and run the loop                         */
+/*----------------------------------------------------------------------------*/
+
+static float LchPar(ParSct *par, int TypIdx1, int TypIdx2,
+                     void *prc, void *PtrArg )
+{
+   int      i;
+   float    acc = 0.;
+   PthSct   *pth;
+   TypSct   *typ1, *typ2 = NULL;
+   GrpSct   *grp;
+
    typ1 =  &par->TypTab[ TypIdx1 ];
 
-   // Launch small WP with static scheduling
+   // Restore the sort by number of dependencies after an update
+   if(typ1->SrtUpd)
+      SrtSmlWrk(typ1, 1);
+
+   // Launch small WP with static scheduling: each thread runs its part
+   // of every group in turn, only waiting for the parts of former groups
+   // it conflicts with, instead of having a global barrier between groups
    if( (TypIdx2 > 0) && !par->DynSch )
    {
-      grp = typ1->NexGrp;
-
-      do
+      // Ordered groups must follow the blocks or the order would be lost
+      if( typ1->OrdDep && typ1->OrdUpd
+      && (!SetOrd(par, typ1) || !SetOrdGrp(par, typ1)) )
       {
-         // Lock acces to global parameters
-         pthread_mutex_lock(&par->ParMtx);
+         return(-1.);
+      }
 
-         par->cmd = RunDetWrk;
-         par->prc = (void (*)(itg, itg, int, void *))prc;
-         par->arg = PtrArg;
-         par->typ1 = typ1;
-         par->typ2 = NULL;
-         par->WrkCpt = 0;
+      // Plain groups must follow the dependencies updated since they were set
+      if( !typ1->OrdDep && typ1->OrdUpd && typ1->NexGrp && !SetGrp(par, typ1) )
+         return(-1.);
 
-         for(i=0;i<par->NmbCpu;i++)
-         {
-            pth = &par->PthTab[i];
-            pth->NmbDetWrk = grp->NmbSmlWrk[i];
-            pth->DetWrkTab = grp->SmlWrkTab[i];
-            acc += (float)grp->NmbSmlWrk[i];
-         }
+      // Lock acces to global parameters
+      pthread_mutex_lock(&par->ParMtx);
+
+      par->cmd = RunDetWrk;
+      par->prc = (void (*)(itg, itg, int, void *))prc;
+      par->arg = PtrArg;
+      par->typ1 = typ1;
+      par->typ2 = NULL;
+      par->WrkCpt = 0;
+
+      for(i=0;i<par->NmbCpu;i++)
+         par->PthTab[i].DonGrp = 0;
 
+      for(grp = typ1->NexGrp; grp; grp = grp->nex)
          for(i=0;i<par->NmbCpu;i++)
-         {
-            pth = &par->PthTab[i];
-            pthread_mutex_lock(&pth->mtx);
-            pthread_cond_signal(&pth->cnd);
-            pthread_mutex_unlock(&pth->mtx);
-         }
+            acc += (float)grp->NmbSmlWrk[i];
 
-         pthread_cond_wait(&par->ParCnd, &par->ParMtx);
+      RunTre(par, par->NmbCpu);
 
-         pthread_mutex_unlock(&par->ParMtx);
-         grp = grp->nex;
-      }while(grp);
+      pthread_mutex_unlock(&par->ParMtx);
 
       acc /= (float)(par->NmbSmlBlk * typ1->NmbGrp) / (float)WrkPerGrp;
    }
+   else if( (TypIdx2 > 0) && par->DynSch && par->RplSch
+         && (typ1->RplTyp == TypIdx2) && !typ1->AdpUpd )
+   {
+      // Replay the recorded dynamic schedule: each thread runs its former
+      // WP in the same order and only waits for the conflicting WP that
+      // other threads ran before, without going through NexWrk
+      pthread_mutex_lock(&par->ParMtx);
+
+      par->cmd = RunRplWrk;
+      par->prc = (void (*)(itg, itg, int, void *))prc;
+      par->arg = PtrArg;
+      par->typ1 = typ1;
+      par->typ2 = NULL;
+      par->WrkCpt = 0;
+      par->RplWai = 0;
+
+      // A new epoch makes all completion flags stale at once
+      typ1->RplEpo++;
+
+      RunTre(par, par->NmbCpu);
+
+      pthread_mutex_unlock(&par->ParMtx);
+
+      if(typ1->NodTab)
+         UpdNod(typ1);
+
+      acc = typ1->RplAcc;
+   }
    else if( (TypIdx2 > 0) && par->DynSch )
    {
       // Launch small WP with dynamic scheduling
@@ -706,32 +1317,60 @@ float LaunchParallel(int64_t ParIdx, int TypIdx1, int TypIdx2,
       par->NexWrk = typ1->SmlWrkTab;
       par->BufCpt = 0;
       par->WrkCpt = 0;
-      par->sta[0] = par->sta[1] = 0.;
       par->req = 0;
       par->NmbDep = 0;
 
-      // Clear running wp
+      // Clear running wp and stats
       for(i=0;i<par->NmbCpu;i++)
+      {
          par->PthTab[i].wrk = NULL;
+         par->PthTab[i].sta[0] = par->PthTab[i].sta[1] = 0.;
+      }
 
       ClrWrd(typ1->NmbDepWrd, typ1->RunDepTab);
 
-      // Build a linked list of wp
-      for(i=0;i<par->typ1->NmbSmlWrk;i++)
-      {
-         typ1->SmlWrkTab[i].pre = &typ1->SmlWrkTab[ i-1 ];
-         typ1->SmlWrkTab[i].nex = &typ1->SmlWrkTab[ i+1 ];
-      }
+      // Bring the WP in line with the adaptive tree if it has been modified
+      if(typ1->AdpUpd)
+         SetAdpWrk(typ1);
 
-      typ1->SmlWrkTab[0].pre = typ1->SmlWrkTab[ typ1->NmbSmlWrk - 1 ].nex = NULL;
+      // Record the order and threads the WP are given to, to be replayed
+      typ1->RplTyp = typ1->NmbRpl = 0;
+      typ1->RplRec = (par->RplSch || par->RplFrc) && AlcRpl(par, typ1);
 
-      // Main loop: wake up threads and wait for completion or blocked threads
-      do
+      // Ordered dependencies start with the WP without predecessors,
+      // with cache affinity, threads get the WP they ran the last time
+      if(typ1->OrdDep)
       {
-         // Search for some idle threads
-         par->req = 0;
+         if(typ1->OrdUpd && !SetOrd(par, typ1))
+         {
+            pthread_mutex_unlock(&par->ParMtx);
+            par->typ1 = NULL;
+            return(-1.);
+         }
 
-         for(i=0;i<par->NmbCpu;i++)
+         RstOrd(typ1);
+      }
+      else if(!par->AffSch || !SetAffLst(par, typ1))
+      {
+         // Build a linked list of wp
+         for(i=0;i<par->typ1->NmbSmlWrk;i++)
+         {
+            typ1->SmlWrkTab[i].pre = &typ1->SmlWrkTab[ i-1 ];
+            typ1->SmlWrkTab[i].nex = &typ1->SmlWrkTab[ i+1 ];
+         }
+
+         typ1->SmlWrkTab[0].pre = typ1->SmlWrkTab[ typ1->NmbSmlWrk - 1 ].nex = NULL;
+      }
+
+      // Main loop: wake up threads and wait for completion or blocked threads
+      // Only the first NmbTem threads are involved if the launch policy
+      // decided to run the loop on a partial team
+      do
+      {
+         // Search for some idle threads
+         par->req = 0;
+
+         for(i=0;i<par->NmbTem;i++)
          {
             pth = &par->PthTab[i];
 
@@ -760,8 +1399,22 @@ float LaunchParallel(int64_t ParIdx, int TypIdx1, int TypIdx2,
 
       pthread_mutex_unlock(&par->ParMtx);
 
+      // Refine the slow blocks and coarsen the cheap ones for the next launch
+      if(typ1->NodTab)
+         UpdNod(typ1);
+
       // Compute the average concurrency factor
-      acc = par->sta[0] ? (par->sta[1] / par->sta[0]) : 0;
+      acc = SumSta(par);
+
+      // Derive each WP's waits from the recorded schedule
+      if(typ1->RplRec)
+      {
+         typ1->RplRec = 0;
+         typ1->RplAcc = acc;
+
+         if(SetRpl(par, typ1))
+            typ1->RplTyp = TypIdx2;
+      }
    }
    else if(!TypIdx2)
    {
@@ -780,22 +1433,18 @@ float LaunchParallel(int64_t ParIdx, int TypIdx1, int TypIdx2,
       for(i=0;i<par->NmbCpu;i++)
       {
          pth = &par->PthTab[i];
-         pth->wrk = &typ1->BigWrkTab[i];
+         pth->big = &typ1->BigWrkTab[i];
       }
 
       // Update block interleaving according to the current attributes
-      if( (par->NmbItlBlk != 1) || par->ItlBlkSiz)
-         SetItlBlk(par, typ1);
-
-      for(i=0;i<par->NmbCpu;i++)
+      // or restore plain blocks if interleaving has been disabled since
+      if( (par->NmbItlBlk != 1) || par->ItlBlkSiz || (typ1->NmbItlBlk > 1) )
       {
-         pth = &par->PthTab[i];
-         pthread_mutex_lock(&pth->mtx);
-         pthread_cond_signal(&pth->cnd);
-         pthread_mutex_unlock(&pth->mtx);
+         SetItlBlk(par, typ1);
+         typ1->NmbItlBlk = par->NmbItlBlk;
       }
 
-      pthread_cond_wait(&par->ParCnd, &par->ParMtx);
+      RunTre(par, par->NmbCpu);
 
       pthread_mutex_unlock(&par->ParMtx);
 
@@ -817,30 +1466,62 @@ float LaunchParallel(int64_t ParIdx, int TypIdx1, int TypIdx2,
 
 
 /*----------------------------------------------------------------------------*/
-/* Launch a parallel procudure with variable arguments.                       */
+/* Launch a parallel procudure taking 32 bit indices and variable arguments.  */
 /* Arguments are passed as pointer to void.                                   */
 /*----------------------------------------------------------------------------*/
 
-float LaunchParallelMultiArg( int64_t ParIdx, int TypIdx1, int TypIdx2,
-                              void *prc, int NmbArg, ... )
+float LaunchParallelMultiArg32( int64_t ParIdx, int TypIdx1, int TypIdx2,
+                                void *prc, int NmbArg, ... )
+{
+   float acc;
+   va_list ArgLst;
+
+   va_start(ArgLst, NmbArg);
+   acc = LchVar((ParSct *)ParIdx, LplInt, TypIdx1, TypIdx2, prc, NmbArg, ArgLst);
+   va_end(ArgLst);
+
+   return(acc);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Launch a parallel procudure taking 64 bit indices and variable arguments.  */
+/* Arguments are passed as pointer to void.                                   */
+/*----------------------------------------------------------------------------*/
+
+float LaunchParallelMultiArg64( int64_t ParIdx, int TypIdx1, int TypIdx2,
+                                void *prc, int NmbArg, ... )
 {
-   int i;
    float acc;
    va_list ArgLst;
-   ParSct *par = (ParSct *)ParIdx;
 
-   if(NmbArg > 20)
+   va_start(ArgLst, NmbArg);
+   acc = LchVar((ParSct *)ParIdx, LplLng, TypIdx1, TypIdx2, prc, NmbArg, ArgLst);
+   va_end(ArgLst);
+
+   return(acc);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Store the variable arguments and launch the procedure                      */
+/*----------------------------------------------------------------------------*/
+
+static float LchVar( ParSct *par, int wid, int TypIdx1, int TypIdx2,
+                     void *prc, int NmbArg, va_list ArgLst )
+{
+   int i;
+   float acc;
+
+   if(!par || (NmbArg > 20))
       return(-1.);
 
    par->NmbVarArg = NmbArg;
-   va_start(ArgLst, NmbArg);
 
    for(i=0;i<NmbArg;i++)
       par->VarArgTab[i] = va_arg(ArgLst, void *);
 
-   va_end(ArgLst);
-
-   acc = LaunchParallel(ParIdx, TypIdx1, TypIdx2, prc, NULL);
+   acc = LchWid(par, wid, TypIdx1, TypIdx2, prc, NULL);
    par->NmbVarArg = 0;
 
    return(acc);
@@ -848,1575 +1529,6667 @@ float LaunchParallelMultiArg( int64_t ParIdx, int TypIdx1, int TypIdx2,
 
 
 /*----------------------------------------------------------------------------*/
-/* Pthread handler, waits for job, does it, then signal end                   */
+/* Run a loop inline, on a partial team or on the full pool depending on the  */
+/* cost of the procedure compared to the threads' wake-up time                */
 /*----------------------------------------------------------------------------*/
 
-static void *PthHdl(void *ptr)
+static float PolLch(ParSct *par, int TypIdx1, int TypIdx2,
+                    void *prc, void *PtrArg)
 {
-   itg i, beg, end;
-   PthSct *pth = (PthSct *)ptr;
-   ParSct *par = pth->par;
+   int      NmbPth;
+   itg      BegIdx = 1, SmpIdx;
+   float    acc;
+   double   tim;
+   PolSct   *pol;
+   TypSct   *typ = &par->TypTab[ TypIdx1 ];
 
-   // Tell the scheduler if all threads are ready
-   pthread_mutex_lock(&par->ParMtx);
-   par->WrkCpt++;
-   pthread_cond_signal(&par->ParCnd);
-   pthread_mutex_lock(&pth->mtx);
-   pthread_mutex_unlock(&par->ParMtx);
+   // Fall back to a regular launch if the policy table is full
+   if(!typ->NmbLin || (TypIdx2 < 0) || !(pol = GetPol(par, TypIdx1, TypIdx2, prc)))
+      return(LchPar(par, TypIdx1, TypIdx2, prc, PtrArg));
 
-   // Enter main loop until StopParallel is send
-   do
-   {
-      // Wait for a wake-up signal from the main loop
-      pthread_cond_wait(&pth->cnd, &pth->mtx);
+   par->prc = (void (*)(itg, itg, int, void *))prc;
+   par->arg = PtrArg;
 
-      // Update stats
-      par->sta[0]++;
+   if(!pol->EntTim && !TypIdx2)
+   {
+      // The first launch of an independent loop runs its first small WP
+      // on the calling thread to measure the cost per entity
+      SmpIdx = MIN(typ->SmlWrkSiz, typ->NmbLin);
+      tim = GetWallClock();
 
-      for(i=0;i<par->NmbCpu;i++)
-         if(par->PthTab[i].wrk)
-            par->sta[1]++;
+      CalPrc(par, 1, SmpIdx, 0);
 
-      switch(par->cmd)
-      {
-         // Call user's procedure with big WP
-         case RunBigWrk :
-         {
-            // Loop over the interleaved blocks
-            for(i=0;i<par->NmbItlBlk;i++)
-            {
-               beg = pth->wrk->ItlTab[i][0];
-               end = pth->wrk->ItlTab[i][1];
+      tim = GetWallClock() - tim;
+      pol->EntTim = MAX(tim / SmpIdx, DBL_MIN);
+      BegIdx = SmpIdx + 1;
 
-               if(!beg || !end || (end < beg))
-                  continue;
+      if(BegIdx > typ->NmbLin)
+         return(1.);
+   }
+   else if(!pol->EntTim)
+   {
+      // Dependency loops cannot be split, so the first launch
+      // is timed on the full pool instead
+      tim = GetWallClock();
+      acc = LchPar(par, TypIdx1, TypIdx2, prc, PtrArg);
+      tim = GetWallClock() - tim;
+      pol->EntTim = MAX((tim - par->WakTim) * par->NmbCpu / typ->NmbLin, DBL_MIN);
+      return(acc);
+   }
 
-               if(par->clk)
-                  pth->wrk->RunTim = GetWallClock();
+   // Update the team size whenever the type has been resized
+   if(pol->NmbLin != typ->NmbLin)
+   {
+      pol->NmbPth = SetPolPth(par, pol->EntTim * typ->NmbLin);
+      pol->NmbLin = typ->NmbLin;
+   }
 
-               // Launch a single big wp and signal completion to the scheduler
-               if(par->NmbVarArg)
-                  CalVarArgPrc(beg, end, pth->idx, par);
-               else
-                  par->prc(beg, end, pth->idx, par->arg);
+   NmbPth = pol->NmbPth;
 
-               if(par->clk)
-                  pth->wrk->RunTim = GetWallClock() - pth->wrk->RunTim;
-            }
+   // Cheap loops are run by the calling thread without waking up the pool
+   if(NmbPth <= 1)
+   {
+      CalPrc(par, BegIdx, typ->NmbLin, 0);
 
-            pthread_mutex_lock(&par->ParMtx);
-            par->WrkCpt++;
+      return(1.);
+   }
 
-            if(par->WrkCpt >= par->NmbCpu)
-               pthread_cond_signal(&par->ParCnd);
+   // Dynamic dependency loops only dispatch WP to the first NmbPth threads
+   if(TypIdx2 && par->DynSch)
+   {
+      par->NmbTem = NmbPth;
+      acc = LchPar(par, TypIdx1, TypIdx2, prc, PtrArg);
+      par->NmbTem = par->NmbCpu;
+      return(acc);
+   }
 
-            pthread_mutex_unlock(&par->ParMtx);
-         }break;
+   // Static groups and unsplit full-pool loops keep the regular launcher
+   // to preserve determinism, interleaving and adaptive sizing
+   if(TypIdx2 || ((BegIdx == 1) && (NmbPth == par->NmbCpu)))
+      return(LchPar(par, TypIdx1, TypIdx2, prc, PtrArg));
 
-         // Call user's procedure with small WP using dynamic scheduling
-         case RunSmlWrk :
-         {
-            do
-            {
-               // Run the WP
-               if(par->NmbVarArg)
-                  CalVarArgPrc(pth->wrk->BegIdx, pth->wrk->EndIdx, pth->idx, par);
-               else
-                  par->prc(pth->wrk->BegIdx, pth->wrk->EndIdx, pth->idx, par->arg);
+   TemLch(par, typ, BegIdx, typ->NmbLin, NmbPth, 1);
 
-               // Locked acces to global parameters: 
-               // update WP count, tag WP done and signal the main loop
-               pthread_mutex_lock(&par->ParMtx);
+   return((float)NmbPth);
+}
 
-               par->WrkCpt++;
 
-               if(!(pth->wrk = NexWrk(par, pth->idx)))
-               {
-                  par->req = 1;
-                  pthread_cond_signal(&par->ParCnd);
-                  pthread_mutex_unlock(&par->ParMtx);
-                  break;
-               }
+/*----------------------------------------------------------------------------*/
+/* Split a range of lines among the first NmbPth threads and run them         */
+/* with NmbItl interleaved blocks per thread                                  */
+/*----------------------------------------------------------------------------*/
 
-               if(par->req)
-                  pthread_cond_signal(&par->ParCnd);
+static void TemLch(  ParSct *par, TypSct *typ, itg BegIdx, itg EndIdx,
+                     int NmbPth, int NmbItl )
+{
+   int      i, j, NmbItlBlk = par->NmbItlBlk;
+   itg      siz, idx = BegIdx;
+   double   org = 0., cst = 0.;
+   BigSct   *big;
 
-               pthread_mutex_unlock(&par->ParMtx);
-            }while(1);
-         }break;
+   NmbPth = (int)MIN(NmbPth, EndIdx - BegIdx + 1);
+   NmbItl = (int)MAX(1, MIN(MIN(NmbItl, MaxItlBlk), (EndIdx - BegIdx + 1) / NmbPth));
+   siz = (EndIdx - BegIdx + 1) / (NmbPth * NmbItl);
 
-         // Call user's procedure with small WP using dynamic scheduling
-         case RunGrnWrk :
-         {
-            do
-            {
-               // Run the WP
-               if(par->NmbVarArg)
-                  CalVarArgPrc(pth->wrk->BegIdx, pth->wrk->EndIdx, pth->wrk->GrnIdx, par);
-               else
-                  par->prc(pth->wrk->BegIdx, pth->wrk->EndIdx, pth->wrk->GrnIdx, par->arg);
+   // Weighted types share the range's cost evenly among the ranges
+   if(typ && typ->CstSum && (EndIdx <= typ->CstLin))
+   {
+      org = typ->CstSum[ BegIdx - 1 ];
+      cst = (typ->CstSum[ EndIdx ] - org) / (NmbPth * NmbItl);
+   }
 
-               // Locked acces to global parameters: 
-               // update WP count, tag WP done and signal the main loop
-               pthread_mutex_lock(&par->ParMtx);
+   // Lock acces to global parameters
+   pthread_mutex_lock(&par->ParMtx);
 
-               par->WrkCpt++;
+   par->cmd = RunBigWrk;
+   par->typ1 = typ;
+   par->typ2 = NULL;
+   par->WrkCpt = 0;
+   par->NmbTem = NmbPth;
+   par->NmbItlBlk = NmbItl;
 
-               if(!(pth->wrk = NexGrn(par, pth->idx)))
-               {
-                  par->req = 1;
-                  pthread_cond_signal(&par->ParCnd);
-                  pthread_mutex_unlock(&par->ParMtx);
-                  break;
-               }
+   // Give each member of the team NmbItl ranges of lines in a round robin way,
+   // the last one gets the remaining lines
+   for(j=0;j<NmbItl;j++)
+      for(i=0;i<NmbPth;i++)
+      {
+         big = &par->TemWrkTab[i];
+         big->ItlTab[j][0] = idx;
 
-               if(par->req)
-                  pthread_cond_signal(&par->ParCnd);
+         if(cst > 0.)
+            idx = MAX(idx, MIN(EndIdx + 1,
+                  CstIdx(typ, (double)(j * NmbPth + i + 1), cst, org)));
+         else
+            idx += siz;
 
-               pthread_mutex_unlock(&par->ParMtx);
-            }while(1);
-         }break;
+         big->ItlTab[j][1] = idx - 1;
+         par->PthTab[i].big = big;
+      }
 
-         // Call user's procedure with small WP using static scheduling
-         case RunDetWrk :
-         {
-            // Loop over the groups' WP
-            for(i=0;i<pth->NmbDetWrk;i++)
-            {
-               beg = pth->DetWrkTab[i]->BegIdx;
-               end = pth->DetWrkTab[i]->EndIdx;
+   par->TemWrkTab[ NmbPth - 1 ].ItlTab[ NmbItl - 1 ][1] = EndIdx;
 
-               if(par->NmbVarArg)
-                  CalVarArgPrc(beg, end, pth->idx, par);
-               else
-                  par->prc(beg, end, pth->idx, par->arg);
-            }
+   RunTre(par, NmbPth);
 
-            pthread_mutex_lock(&par->ParMtx);
-            par->WrkCpt++;
+   pthread_mutex_unlock(&par->ParMtx);
 
-            if(par->WrkCpt >= par->NmbCpu)
-               pthread_cond_signal(&par->ParCnd);
+   par->NmbTem = par->NmbCpu;
+   par->NmbItlBlk = NmbItlBlk;
+   par->typ1 = NULL;
+}
 
-            pthread_mutex_unlock(&par->ParMtx);
-         }break;
 
-         case ClrMem :
-         {
-            // Clear memory and signal completion to the scheduler
-            memset(pth->ClrAdr, 0, pth->ClrMemSiz);
+/*----------------------------------------------------------------------------*/
+/* Choose the team size minimizing wake-up plus computing times               */
+/*----------------------------------------------------------------------------*/
 
-            pthread_mutex_lock(&par->ParMtx);
-            par->WrkCpt++;
-            pthread_cond_signal(&par->ParCnd);
-            pthread_mutex_unlock(&par->ParMtx);
-         }break;
+static int SetPolPth(ParSct *par, double TotTim)
+{
+   int      NmbPth;
+   double   PthTim = par->WakTim / par->NmbCpu;
 
-         case CpyMem :
-         {
-            // Copy memory and signal completion to the scheduler
-            memcpy(pth->DstAdr, pth->SrcAdr, pth->CpyMemSiz);
+   if(PthTim <= 0.)
+      return(par->NmbCpu);
 
-            pthread_mutex_lock(&par->ParMtx);
-            par->WrkCpt++;
-            pthread_cond_signal(&par->ParCnd);
-            pthread_mutex_unlock(&par->ParMtx);
-         }break;
+   // Waking up n threads costs n * PthTim and divides the work by n:
+   // the optimum is reached with n = sqrt(TotTim / PthTim)
+   NmbPth = (int)sqrt(TotTim / PthTim);
+   NmbPth = MAX(1, MIN(NmbPth, par->NmbCpu));
 
-         case EndPth :
-         {
-            // Destroy the thread mutex and condition and call for join
-            pthread_mutex_unlock(&pth->mtx);
-            pthread_mutex_destroy(&pth->mtx);
-            pthread_cond_destroy(&pth->cnd);
-            return(NULL);
-         }break;
-      }
-   }while(1);
+   // Run inline if even the best team is slower than the calling thread alone
+   if( (NmbPth > 1) && (NmbPth * PthTim + TotTim / NmbPth >= TotTim) )
+      NmbPth = 1;
 
-   return(NULL);
+   return(NmbPth);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Get the next WP to be computed                                             */
+/* Search the policy cache for a procedure-type pair or add a new entry       */
 /*----------------------------------------------------------------------------*/
 
-static WrkSct *NexWrk(ParSct *par, int PthIdx)
+static PolSct *GetPol(ParSct *par, int TypIdx, int TypIdx2, void *prc)
 {
-   PthSct *pth = &par->PthTab[ PthIdx ];
-   WrkSct *wrk;
-
-   // Remove previous work's tags
-   if(pth->wrk)
-      SubWrd(par->typ1->NmbDepWrd, pth->wrk->DepWrdTab, par->typ1->RunDepTab);
+   int      i;
+   PolSct   *pol, *UsrPol = NULL;
 
-   // If the wp's buffer is empty search for some new compatible wp to fill in
-   if(!par->BufCpt)
+   // A loop against another type, or without dependencies, is
+   // another workload and gets its own measure and decision
+   for(i=0;i<par->NmbPol;i++)
    {
-      wrk = par->NexWrk;
+      pol = &par->PolTab[i];
 
-      while(wrk)
-      {
-         // Check for dependencies
-         if(!AndWrd(par->typ1->NmbDepWrd, wrk->DepWrdTab, par->typ1->RunDepTab))
-         {
-            par->BufWrk[ par->BufCpt++ ] = wrk;
+      if( (pol->TypIdx != TypIdx) || (pol->prc != prc) )
+         continue;
 
-            // Unlink wp
-            if(wrk->pre)
-               wrk->pre->nex = wrk->nex;
-            else
-               par->NexWrk = wrk->nex;
+      if(pol->TypIdx2 == TypIdx2)
+         return(pol);
 
-            if(wrk->nex)
-               wrk->nex->pre = wrk->pre;
+      if(pol->UsrCst)
+         UsrPol = pol;
+   }
 
-            // Add new work's tags
-            AddWrd(par->typ1->NmbDepWrd, wrk->DepWrdTab, par->typ1->RunDepTab);
+   if(par->NmbPol >= MaxPol)
+      return(NULL);
 
-            if(par->BufCpt == par->BufMax)
-               break;
-         }
+   pol = &par->PolTab[ par->NmbPol++ ];
+   memset(pol, 0, sizeof(PolSct));
+   pol->TypIdx = TypIdx;
+   pol->TypIdx2 = TypIdx2;
+   pol->prc = prc;
 
-         wrk = wrk->nex;
-      }
+   // A cost given by the user belongs to the procedure whatever the loop
+   if(UsrPol)
+   {
+      pol->EntTim = UsrPol->EntTim;
+      pol->UsrCst = 1;
    }
 
-   // Return the next available wp in buffer and unlink it from the todo list
-   return(par->BufCpt ? par->BufWrk[ --par->BufCpt ] : NULL);
+   return(pol);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Get the next WP to be computed                                             */
+/* Give the per entity cost of a procedure instead of measuring it            */
 /*----------------------------------------------------------------------------*/
 
-static WrkSct *NexGrn(ParSct *par, int PthIdx)
+int SetProcedureCost(int64_t ParIdx, int TypIdx, void *prc, double EntTim)
 {
-   PthSct *pth = &par->PthTab[ PthIdx ];
-   WrkSct *wrk;
-
-   // Remove previous work's tags
-   if(pth->wrk)
-   {
-      ClrBit(par->RunDepTab, pth->wrk->GrnIdx);
-      par->ColCpt[ par->GrnCol[ pth->wrk->GrnIdx ] ]--;
+   int      i;
+   PolSct   *pol;
+   ParSct   *par = (ParSct *)ParIdx;
 
-      if(!par->ColCpt[ par->GrnCol[ pth->wrk->GrnIdx ] ])
-         par->CurCol++;
-   }
+   // Get and check lib parallel instance, type and cost
+   if(!ParIdx || (TypIdx < 1) || (TypIdx > MaxTyp) || !prc || (EntTim <= 0.))
+      return(0);
 
-   wrk = par->NexWrk;
+   if(!par->TypTab[ TypIdx ].NmbLin || !(pol = GetPol(par, TypIdx, 0, prc)))
+      return(0);
 
-   while(wrk && (par->GrnCol[ wrk->GrnIdx ] <= par->CurCol + 1) )
-   {
-      // Check for dependencies
-      if((wrk->GrnIdx <= par->ColTab[ par->CurCol ][1])
-      || ( par->DynSch && (par->CurCol < par->NmbCol)
-         && (wrk->GrnIdx <= par->ColTab[ par->CurCol+1 ][1])
-         && !AndWrd(par->NmbDepWrd, wrk->DepWrdTab, par->RunDepTab) ) )
+   // Apply the cost to the loops against other types already known,
+   // the ones to come inherit it from GetPol()
+   for(i=0;i<par->NmbPol;i++)
+      if( (par->PolTab[i].TypIdx == TypIdx) && (par->PolTab[i].prc == prc) )
       {
-         // Unlink wp
-         if(wrk->pre)
-            wrk->pre->nex = wrk->nex;
-         else
-            par->NexWrk = wrk->nex;
-
-         if(wrk->nex)
-            wrk->nex->pre = wrk->pre;
-
-         // Add new work's tags
-         SetBit(par->RunDepTab, wrk->GrnIdx);
-
-         return(wrk);
+         par->PolTab[i].EntTim = EntTim;
+         par->PolTab[i].UsrCst = 1;
+         par->PolTab[i].NmbLin = 0;
       }
 
-      wrk = wrk->nex;
-   }
+   pol->NmbLin = par->TypTab[ TypIdx ].NmbLin;
+   pol->NmbPth = SetPolPth(par, EntTim * pol->NmbLin);
 
-   return(NULL);
+   return(pol->NmbPth);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Allocate a new kind of elements and set work-packages                      */
+/* Measure the time needed to wake up all threads and wait for them           */
 /*----------------------------------------------------------------------------*/
 
-int NewType(int64_t ParIdx, itg NmbLin)
+static double MesWakTim(ParSct *par)
 {
-   int      TypIdx = 0;
-   itg      i, idx, BigWrkSiz, NmbBigWrk;
-   TypSct   *typ;
-   ParSct   *par = (ParSct *)ParIdx;
+   int      i, j;
+   double   tim, MinTim = DBL_MAX;
+   PthSct   *pth;
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(0);
+   // Send empty memory clears and keep the fastest round trip
+   for(j=0;j<NmbWakItr;j++)
+   {
+      tim = GetWallClock();
+      pthread_mutex_lock(&par->ParMtx);
 
-   if(NmbLin <= 0)
-      return(0);
+      par->cmd = ClrMem;
+      par->WrkCpt = 0;
 
-   // Search for a free type structure
-   for(i=1;i<=MaxTyp;i++)
-      if(!par->TypTab[i].NmbLin)
+      for(i=0;i<par->NmbCpu;i++)
       {
-         TypIdx = i;
-         break;
+         pth = &par->PthTab[i];
+         pth->ClrAdr = (char *)par;
+         pth->ClrMemSiz = 0;
       }
 
-   if(!TypIdx)
-      return(0);
+      RunTre(par, par->NmbCpu);
 
-   typ = &par->TypTab[ TypIdx ];
-   typ->NmbLin = NmbLin;
-   typ->MaxNmbLin = NmbLin * par->SizMul;
-   typ->NexGrp = NULL;
+      pthread_mutex_unlock(&par->ParMtx);
+      MinTim = MIN(MinTim, GetWallClock() - tim);
+   }
 
-   // Compute the size of small work-packages
-   if(NmbLin >= par->NmbSmlBlk * par->NmbCpu)
-   {
-      typ->SmlWrkSiz = NmbLin / (par->NmbSmlBlk * par->NmbCpu);
-      typ->NmbSmlWrk = NmbLin / typ->SmlWrkSiz;
+   return(MinTim);
+}
 
-      if(NmbLin != typ->NmbSmlWrk * typ->SmlWrkSiz)
-         typ->NmbSmlWrk++;
-   }
-   else
-   {
-      typ->SmlWrkSiz = NmbLin;
-      typ->NmbSmlWrk = 1;
-   }
 
-   if(!(typ->SmlWrkTab = LPL_calloc(par->lmb, typ->NmbSmlWrk * par->SizMul , sizeof(WrkSct))))
-      return(0);
+/*----------------------------------------------------------------------------*/
+/* Launch a loop with its tuned settings or try a new candidate setting       */
+/*----------------------------------------------------------------------------*/
 
-   // Set small work-packages
-   idx = 0;
+static float TunLch( ParSct *par, int TypIdx1, int TypIdx2,
+                     void *prc, void *PtrArg )
+{
+   float    acc;
+   double   tim;
+   TunSct   *tun;
+   TypSct   *typ1 = &par->TypTab[ TypIdx1 ];
 
-   for(i=0;i<typ->NmbSmlWrk;i++)
+   // Procedures that are not tuned get the regular treatment
+   if(!typ1->NmbLin || (TypIdx2 < 0) || !(tun = GetTun(par, TypIdx1, TypIdx2, prc)))
    {
-      typ->SmlWrkTab[i].BegIdx = idx + 1;
-      typ->SmlWrkTab[i].EndIdx = idx + typ->SmlWrkSiz;
-      idx += typ->SmlWrkSiz;
+      if(par->LchPol)
+         return(PolLch(par, TypIdx1, TypIdx2, prc, PtrArg));
+      else
+         return(LchPar(par, TypIdx1, TypIdx2, prc, PtrArg));
    }
 
-   typ->SmlWrkTab[ typ->NmbSmlWrk - 1 ].EndIdx = NmbLin;
-
-   // Compute the size of big work-packages
-   if(!(typ->BigWrkTab = LPL_calloc(par->lmb, par->NmbCpu * par->SizMul , sizeof(WrkSct))))
-      return(0);
-
-   // Compute the size of big work-packages
-	if(NmbLin >= par->NmbCpu)
-	{
-		BigWrkSiz = NmbLin / par->NmbCpu;
-		NmbBigWrk = par->NmbCpu;
-	}
-	else
-	{
-		BigWrkSiz = NmbLin;
-		NmbBigWrk = 1;
-	}
-
-	// Set big work-packages
-	idx = 0;
-
-	for(i=0;i<NmbBigWrk;i++)
-	{
-		typ->BigWrkTab[i].ItlTab[0][0] = idx + 1;
-		typ->BigWrkTab[i].ItlTab[0][1] = idx + BigWrkSiz;
-		idx += BigWrkSiz;
-	}
+   // Frozen settings are simply applied
+   if(tun->phs == TunEnd)
+   {
+      SetTunTyp(par, tun);
+      return(RunTun(par, TypIdx1, TypIdx2, prc, PtrArg, tun->NmbPth, tun->NmbItl));
+   }
 
-	typ->BigWrkTab[ NmbBigWrk - 1 ].ItlTab[0][1] = NmbLin;
+   // Otherwise, time the current candidate and move on to the next one
+   tim = GetWallClock();
+   acc = RunTun(par, TypIdx1, TypIdx2, prc, PtrArg, tun->CurPth, tun->CurItl);
+   tim = GetWallClock() - tim;
+   NxtTun(par, tun, tim);
 
-   return(TypIdx);
+   return(acc);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Adaptive big block resizing based on run time                              */
+/* Run a loop with a given number of threads and interleaved blocks           */
 /*----------------------------------------------------------------------------*/
 
-static void UpdBlkSiz(ParSct *par, TypSct *typ)
+static float RunTun( ParSct *par, int TypIdx1, int TypIdx2, void *prc,
+                     void *PtrArg, int NmbPth, int NmbItl )
 {
-   int      i, CurBlk = 0;
-   itg      CurLin = 0, NewBlk[ MaxPth ][2];
-   double   sca, AvgTim, RemTim, TotTim = 0.;
+   int      NmbItlBlk, ItlBlkSiz;
+   float    acc;
+   TypSct   *typ1 = &par->TypTab[ TypIdx1 ];
 
-   for(i=0;i<par->NmbCpu;i++)
-      TotTim += typ->BigWrkTab[i].RunTim;
+   // A single thread means that the calling one runs the whole loop
+   if(NmbPth <= 1)
+   {
+      par->prc = (void (*)(itg, itg, int, void *))prc;
+      par->arg = PtrArg;
 
-   AvgTim = TotTim / par->NmbCpu;
+      CalPrc(par, 1, typ1->NmbLin, 0);
 
-   for(i=0;i<par->NmbCpu;i++)
-   {
-      NewBlk[i][0] = CurLin + 1;
-      TotTim = 0;
+      return(1.);
+   }
 
-      do
-      {
-         RemTim = (typ->BigWrkTab[ CurBlk ].RunTim
-                * (typ->BigWrkTab[ CurBlk ].ItlTab[0][1] - CurLin))
-                / (typ->BigWrkTab[ CurBlk ].ItlTab[0][1]
-                - typ->BigWrkTab[ CurBlk ].ItlTab[0][0]);
+   // Dependency loops are restricted to the first NmbPth threads
+   if(TypIdx2)
+   {
+      if(par->DynSch)
+         par->NmbTem = MIN(NmbPth, par->NmbCpu);
 
-         if(TotTim + RemTim < AvgTim)
-         {
-            CurLin = typ->BigWrkTab[ CurBlk ].ItlTab[0][1];
-            TotTim += RemTim;
-            CurBlk++;
-         }
-         else
-         {
-            sca = (AvgTim - TotTim) / typ->BigWrkTab[ CurBlk ].RunTim;
-            CurLin += sca * (typ->BigWrkTab[ CurBlk ].ItlTab[0][1]
-                           - typ->BigWrkTab[ CurBlk ].ItlTab[0][0]);
-            break;
-         }
-      }while(TotTim < AvgTim);
+      acc = LchPar(par, TypIdx1, TypIdx2, prc, PtrArg);
+      par->NmbTem = par->NmbCpu;
 
-      NewBlk[i][1] = CurLin;
+      return(acc);
    }
 
-   NewBlk[ par->NmbCpu - 1 ][1] = typ->NmbLin;
-
-	for(i=0;i<par->NmbCpu;i++)
+   // The full pool uses the type's big WP with the tuned interleaving factor
+   if(NmbPth >= par->NmbCpu)
    {
-      typ->BigWrkTab[i].ItlTab[0][0] = NewBlk[i][0];
-      typ->BigWrkTab[i].ItlTab[0][1] = NewBlk[i][1];
+      NmbItlBlk = par->NmbItlBlk;
+      ItlBlkSiz = par->ItlBlkSiz;
+      par->NmbItlBlk = NmbItl;
+      par->ItlBlkSiz = 0;
+      acc = LchPar(par, TypIdx1, TypIdx2, prc, PtrArg);
+      par->NmbItlBlk = NmbItlBlk;
+      par->ItlBlkSiz = ItlBlkSiz;
+
+      return(acc);
    }
+
+   // While a partial team gets its own blocks
+   par->prc = (void (*)(itg, itg, int, void *))prc;
+   par->arg = PtrArg;
+   TemLch(par, typ1, 1, typ1->NmbLin, NmbPth, NmbItl);
+
+   return((float)NmbPth);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Resize a data type up to a two fold increase                               */
+/* Search for the tuning entry of a procedure or create a new one             */
 /*----------------------------------------------------------------------------*/
 
-int ResizeType(int64_t ParIdx, int TypIdx, itg NmbLin)
+static TunSct *GetTun(ParSct *par, int TypIdx1, int TypIdx2, void *prc)
 {
-   itg      i, idx, BigWrkSiz, NmbBigWrk;
-   TypSct   *typ;
-   ParSct   *par = (ParSct *)ParIdx;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(0);
-
-   // Check bounds and free mem
-   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
-      return(0);
+   int      i, rnk = 0;
+   itg      NmbLin1, NmbLin2;
+   TunSct   *tun;
+   TypSct   *typ1 = &par->TypTab[ TypIdx1 ];
 
-   typ = &par->TypTab[ TypIdx ];
+   for(i=0;i<par->NmbTun;i++)
+   {
+      tun = &par->TunTab[i];
 
-   if( (NmbLin < typ->NmbLin) || (NmbLin > typ->MaxNmbLin) )
-      return(0);
+      if( (tun->TypIdx1 != TypIdx1) || (tun->TypIdx2 != TypIdx2) || !tun->prc )
+         continue;
 
-   // Set small work-packages
-   i = typ->NmbSmlWrk;
-   idx = typ->NmbLin;
-   typ->NmbLin = NmbLin;
+      if(tun->prc == prc)
+         return(tun);
 
-   while(idx < NmbLin)
-   {
-      typ->SmlWrkTab[i].BegIdx = idx + 1;
-      typ->SmlWrkTab[i].EndIdx = idx + typ->SmlWrkSiz;
-      i++;
-      idx += typ->SmlWrkSiz;
-      typ->NmbSmlWrk++;
+      rnk++;
    }
 
-   typ->SmlWrkTab[ typ->NmbSmlWrk - 1 ].EndIdx = NmbLin;
-
-   // Compute the size of big work-packages
-	if(NmbLin >= par->NmbCpu)
-	{
-		BigWrkSiz = NmbLin / par->NmbCpu;
-		NmbBigWrk = par->NmbCpu;
-	}
-	else
-	{
-		BigWrkSiz = NmbLin;
-		NmbBigWrk = 1;
-	}
+   // Procedures' addresses change from one run to another, so entries loaded
+   // from a file are identified by the rank of first launch on a type pair
+   NmbLin1 = typ1->NmbLin;
+   NmbLin2 = TypIdx2 ? par->TypTab[ TypIdx2 ].NmbLin : 0;
 
-	// Set big work-packages
-	idx = 0;
+   for(i=0;i<par->NmbTun;i++)
+   {
+      tun = &par->TunTab[i];
 
-	for(i=0;i<NmbBigWrk;i++)
-	{
-		typ->BigWrkTab[i].ItlTab[0][0] = idx + 1;
-		typ->BigWrkTab[i].ItlTab[0][1] = idx + BigWrkSiz;
-		idx += BigWrkSiz;
-	}
+      if( !tun->prc && (tun->TypIdx1 == TypIdx1) && (tun->TypIdx2 == TypIdx2)
+      &&  (tun->rnk == rnk) && (tun->NmbLin1 == NmbLin1)
+      &&  (tun->NmbLin2 == NmbLin2) )
+      {
+         tun->prc = prc;
+         return(tun);
+      }
+   }
 
-	typ->BigWrkTab[ NmbBigWrk - 1 ].ItlTab[0][1] = NmbLin;
+   if(!par->AutTun || (par->NmbTun >= MaxTun))
+      return(NULL);
 
-   return(TypIdx);
+   // Start a new exploration from the current settings with the full pool
+   tun = &par->TunTab[ par->NmbTun++ ];
+   memset(tun, 0, sizeof(TunSct));
+   tun->TypIdx1 = TypIdx1;
+   tun->TypIdx2 = TypIdx2;
+   tun->NmbLin1 = NmbLin1;
+   tun->NmbLin2 = NmbLin2;
+   tun->rnk = rnk;
+   tun->prc = prc;
+   tun->phs = TunPth;
+   tun->BstTim = DBL_MAX;
+   tun->NmbPth = tun->CurPth = par->NmbCpu;
+   tun->NmbItl = tun->CurItl = 1;
+   tun->SrtFlg = tun->CurSrt = typ1->SrtFlg;
+   tun->SmlLvl = typ1->SmlLvl;
+   tun->DepLvl = typ1->DepLvl;
+
+   // Static groups are bound to the whole pool and to the current blocks
+   if(TypIdx2 && !par->DynSch)
+      tun->phs = TunEnd;
+
+   return(tun);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Set big work blocks interleaving                                           */
+/* Accumulate a candidate's run time and select the next candidate            */
 /*----------------------------------------------------------------------------*/
 
-static void SetItlBlk(ParSct *par, TypSct *typ)
+static void NxtTun(ParSct *par, TunSct *tun, double tim)
 {
-   itg      i, j, BegIdx, EndIdx, CpuIdx = 0, PagIdx[ MaxPth ] = {0};
-   double   ItlSiz, ItlIdx = 0.;
+   double   AvgTim;
+   TypSct   *typ1 = &par->TypTab[ tun->TypIdx1 ];
 
-   // Set big WP interleaved indices and block sizes if requested
-   if(par->NmbItlBlk)
-      ItlSiz = (double)typ->NmbLin / (double)(par->NmbItlBlk * par->NmbCpu);
-   else if(par->ItlBlkSiz)
-   {
-      par->NmbItlBlk = typ->NmbLin / (par->ItlBlkSiz * par->NmbCpu);
-      ItlSiz = (double)par->ItlBlkSiz;
-   }
+   tun->tim += tim;
 
-   // In case the block or lines numbers is too small, deactivate interleaving
-   if(!par->NmbItlBlk || !ItlSiz)
-   {
-      par->NmbItlBlk = 1;
-      ItlSiz = (double)typ->NmbLin / (double)(par->NmbCpu);
-   }
+   if(++tun->cnt < par->TunItr)
+      return;
 
-   for(i=0;i<par->NmbCpu;i++)
-   {
-      for(j=0;j<par->NmbItlBlk;j++)
-      {
-         BegIdx = (itg)(ItlIdx + 1.);
-         EndIdx = (itg)(ItlIdx + ItlSiz);
-         ItlIdx += ItlSiz;
+   AvgTim = tun->tim / tun->cnt;
+   tun->tim = 0.;
+   tun->cnt = 0;
 
-         if(BegIdx <= EndIdx)
-         {
-            typ->BigWrkTab[ CpuIdx ].ItlTab[ PagIdx[ CpuIdx ] ][0] = BegIdx;
-            typ->BigWrkTab[ CpuIdx ].ItlTab[ PagIdx[ CpuIdx ] ][1] = EndIdx;
-            PagIdx[ CpuIdx ]++;
-            CpuIdx++;
-            CpuIdx = CpuIdx % par->NmbCpu;
-         }
-      }
+   if(AvgTim < tun->BstTim)
+   {
+      // Keep the candidate as the best known settings
+      // and try to push further in the same direction
+      tun->BstTim = AvgTim;
+      tun->NmbPth = tun->CurPth;
+      tun->NmbItl = tun->CurItl;
+      tun->SrtFlg = tun->CurSrt;
+      tun->SmlLvl = typ1->SmlLvl;
+      tun->DepLvl = typ1->DepLvl;
+      FreSnp(par, tun);
+
+      if(NxtCnd(par, tun))
+         return;
    }
+   else
+      RstCnd(par, tun);
 
-   typ->BigWrkTab[ par->NmbCpu - 1 ].ItlTab[ par->NmbItlBlk - 1 ][1] = typ->NmbLin;
+   // Move on to the next parameter that has some candidates
+   do
+   {
+      tun->phs++;
+      tun->NmbTry = 0;
+   }while( (tun->phs < TunEnd) && !NxtCnd(par, tun) );
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Add this kind of element to the free-list                                  */
+/* Set the next candidate of the current phase, return 0 if there is none     */
 /*----------------------------------------------------------------------------*/
 
-void FreeType(int64_t ParIdx, int TypIdx)
+static int NxtCnd(ParSct *par, TunSct *tun)
 {
-   TypSct *typ;
-   ParSct *par = (ParSct *)ParIdx;
-   GrpSct *grp, *NexGrp;
+   TypSct *typ1 = &par->TypTab[ tun->TypIdx1 ];
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return;
+   // Block sorting and blocks sizes are shared by all procedures running on
+   // this type pair, so they are only explored by the first one to be launched
+   if( (tun->phs >= TunSrt) && (!tun->TypIdx2 || tun->rnk || !typ1->DepWrdMat) )
+      return(0);
 
-   // Check bounds and free mem
-   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
-      return;
+   tun->NmbTry++;
 
-   typ = &par->TypTab[ TypIdx ];
+   switch(tun->phs)
+   {
+      // Halve the number of threads
+      case TunPth :
+      {
+         if(tun->NmbPth < 2)
+            return(0);
 
-   if(typ->SmlWrkTab)
-      LPL_free(par->lmb, typ->SmlWrkTab);
+         tun->CurPth = tun->NmbPth / 2;
+      }break;
 
-   if(typ->BigWrkTab)
-      LPL_free(par->lmb, typ->BigWrkTab);
+      // Double the number of interleaved blocks of independent loops
+      case TunItl :
+      {
+         if( tun->TypIdx2 || (tun->NmbItl * 2 > MaxTunItl)
+         ||  (typ1->NmbLin < (itg)tun->NmbItl * 2 * tun->NmbPth) )
+         {
+            return(0);
+         }
 
-   if(typ->RunDepTab)
-      LPL_free(par->lmb, typ->RunDepTab);
+         tun->CurItl = tun->NmbItl * 2;
+      }break;
 
-   if(typ->DepWrdMat)
-      LPL_free(par->lmb, typ->DepWrdMat);
+      // Try the opposite block ordering
+      case TunSrt :
+      {
+         if(tun->NmbTry > 1)
+            return(0);
 
-   NexGrp = typ->NexGrp;
+         tun->CurSrt = !tun->SrtFlg;
+         SrtSmlWrk(typ1, tun->CurSrt);
+      }break;
 
-   while((grp = NexGrp))
-   {
-      NexGrp = grp->nex;
-      LPL_free(par->lmb, grp);
+      // Halve the number of small blocks while keeping enough of them
+      case TunSml :
+      {
+         if( typ1->NodTab || (typ1->NmbSmlWrk < 4 * tun->NmbPth)
+         ||  !SnpTyp(par, tun) )
+            return(0);
+
+         HlvSml(typ1);
+      }break;
+
+      // Halve the number of dependency blocks
+      case TunDep :
+      {
+         if( typ1->NodTab || (typ1->NmbDepWrd < 2) || !SnpTyp(par, tun) )
+            return(0);
+
+         HlvDep(typ1);
+      }break;
+
+      default : return(0);
    }
 
-   memset(typ, 0, sizeof(TypSct));
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Allocate a dependency matrix linking both types                            */
+/* Revert a slower candidate to the best known settings                       */
 /*----------------------------------------------------------------------------*/
 
-int BeginDependency(int64_t ParIdx, int TypIdx1, int TypIdx2)
+static void RstCnd(ParSct *par, TunSct *tun)
 {
-   int i;
-   TypSct *typ1, *typ2;
-   ParSct *par = (ParSct *)ParIdx;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(0);
+   switch(tun->phs)
+   {
+      case TunPth : tun->CurPth = tun->NmbPth; break;
+      case TunItl : tun->CurItl = tun->NmbItl; break;
 
-   // Check bounds
-   par->CurTyp = typ1 = &par->TypTab[ TypIdx1 ];
-   par->DepTyp = typ2 = &par->TypTab[ TypIdx2 ];
+      case TunSrt :
+      {
+         tun->CurSrt = tun->SrtFlg;
+         SrtSmlWrk(&par->TypTab[ tun->TypIdx1 ], tun->SrtFlg);
+      }break;
 
-   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
-   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin || !typ2->NmbLin)
-   {
-      return(0);
+      case TunSml :
+      case TunDep : RstSnp(par, tun); break;
    }
+}
 
-   // Compute dependency table's size
-   if( (typ2->NmbLin >= par->NmbDepBlk * par->NmbCpu)
-   &&  (typ2->NmbLin >= typ1->DepWrkSiz * 32) )
-   {
-      typ1->DepWrkSiz = typ2->NmbLin / (par->NmbDepBlk * par->NmbCpu);
-      typ1->NmbDepWrd = typ2->NmbLin / (typ1->DepWrkSiz * 32);
 
-      if(typ2->NmbLin != typ1->NmbDepWrd * typ1->DepWrkSiz * 32)
-         typ1->NmbDepWrd++;
-   }
-   else
-   {
-      typ1->DepWrkSiz = typ2->NmbLin;
-      typ1->NmbDepWrd = 1;
-   }
+/*----------------------------------------------------------------------------*/
+/* Bring a type's blocks to the frozen settings of a loaded tuning entry      */
+/*----------------------------------------------------------------------------*/
 
-   // Allocate a global dependency table
-   if(!(typ1->DepWrdMat =
-      LPL_calloc(par->lmb, typ1->NmbSmlWrk * typ1->NmbDepWrd * par->SizMul, sizeof(int))))
-   {
-      return(0);
-   }
+static void SetTunTyp(ParSct *par, TunSct *tun)
+{
+   TypSct *typ1 = &par->TypTab[ tun->TypIdx1 ];
 
-   // Then spread sub-tables among WP
-   for(i=0;i<typ1->NmbSmlWrk;i++)
-   {
-      typ1->SmlWrkTab[i].NmbDep = 0;
-      typ1->SmlWrkTab[i].DepWrdTab =
-         &typ1->DepWrdMat[ i * typ1->NmbDepWrd * par->SizMul ];
-   }
+   if(!tun->TypIdx2 || tun->rnk || !typ1->DepWrdMat || !par->DynSch)
+      return;
 
-   // Allocate a running tags table
-   if(!(typ1->RunDepTab = LPL_calloc(par->lmb, typ1->NmbDepWrd * par->SizMul, sizeof(int))))
-      return(0);
+   while( (typ1->SmlLvl < tun->SmlLvl) && HlvSml(typ1) );
+   while( (typ1->DepLvl < tun->DepLvl) && HlvDep(typ1) );
 
-   return(typ1->NmbDepWrd);
+   if(typ1->SrtFlg != tun->SrtFlg)
+      SrtSmlWrk(typ1, tun->SrtFlg);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Type1 element idx1 depends on type2 element idx2                           */
+/* Order the small WP by decreasing number of dependencies or by index        */
 /*----------------------------------------------------------------------------*/
 
-int AddDependency(int64_t ParIdx, itg idx1, itg idx2)
+static void SrtSmlWrk(TypSct *typ, int SrtFlg)
 {
-   WrkSct *wrk;
-   ParSct *par = (ParSct *)ParIdx;
-
-   // Get and check lib parallel instance
-   if( !par || !par->CurTyp || !par->CurTyp->SmlWrkSiz
-   ||  !par->CurTyp->DepWrkSiz || !par->DepTyp || (idx1 < 1)
-   ||  (idx1 > par->CurTyp->NmbLin) || (idx2 < 1)
-   ||  (idx2 > par->DepTyp->NmbLin) )
-   {
-      return(0);
-   }
-
-   // Set and count dependency bit
-   wrk = &par->CurTyp->SmlWrkTab[ (idx1-1) / par->CurTyp->SmlWrkSiz ];
+   if(SrtFlg)
+      SetPri(typ);
 
-   if(!SetBit(wrk->DepWrdTab, (idx2-1) / par->CurTyp->DepWrkSiz ))
-      wrk->NmbDep++;
-
-   return(wrk->NmbDep);
+   qsort(typ->SmlWrkTab, typ->NmbSmlWrk, sizeof(WrkSct), SrtFlg ? CmpWrk : CmpBeg);
+   typ->SrtFlg = SrtFlg;
+   typ->SrtUpd = 0;
+   ChgWrk(typ);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Set all to all dependencies without any pre-checking                       */
+/* Put sorted small WP back in index order while their dependencies are       */
+/* updated, the next launch sorts them again by number of dependencies        */
 /*----------------------------------------------------------------------------*/
 
-void AddDependencyFast( int64_t ParIdx, int NmbTyp1, itg *TabIdx1,
-                        int NmbTyp2, itg *TabIdx2 )
+static void IdxSmlWrk(TypSct *typ)
 {
-   int i, j;
-   ParSct *par = (ParSct *)ParIdx;
-   WrkSct *wrk;
-
-   for(i=0;i<NmbTyp1;i++)
-   {
-      wrk = &par->CurTyp->SmlWrkTab[ (TabIdx1[i] - 1) / par->CurTyp->SmlWrkSiz ];
+   if(!typ->SrtFlg || typ->SrtUpd)
+      return;
 
-      for(j=0;j<NmbTyp2;j++)
-         if( !SetBit(wrk->DepWrdTab, (TabIdx2[j] - 1) / par->CurTyp->DepWrkSiz ) )
-            wrk->NmbDep++;
-   }
+   qsort(typ->SmlWrkTab, typ->NmbSmlWrk, sizeof(WrkSct), CmpBeg);
+   typ->SrtUpd = 1;
+   ChgWrk(typ);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Type1 element idx1 depends on type2 element idx2                           */
+/* Save a type's small WP and dependency matrix before halving its blocks     */
 /*----------------------------------------------------------------------------*/
 
-int UpdateDependency(int64_t ParIdx, int TypIdx1, int TypIdx2,
-                     itg idx1, itg idx2 )
+static int SnpTyp(ParSct *par, TunSct *tun)
 {
-   WrkSct *wrk;
-   ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ1, *typ2;
+   TypSct   *typ1 = &par->TypTab[ tun->TypIdx1 ];
+   int64_t  NmbWrd = (int64_t)typ1->MaxDepRow * typ1->DepWrdStr;
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(0);
+   FreSnp(par, tun);
 
-   // Check bounds
-   typ1 = &par->TypTab[ TypIdx1 ];
-   typ2 = &par->TypTab[ TypIdx2 ];
+   if(!(tun->SnpWrkTab = LPL_malloc(par->lmb, typ1->NmbSmlWrk * sizeof(WrkSct))))
+      return(0);
 
-   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
-   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin || !typ2->NmbLin
-   ||  !typ1->SmlWrkSiz || !typ1->DepWrkSiz || (idx1 < 1)
-   ||  (idx1 > typ1->MaxNmbLin) || (idx2 < 1) || (idx2 > typ2->MaxNmbLin) )
+   if(!(tun->SnpDepMat = LPL_malloc(par->lmb, NmbWrd * sizeof(int))))
    {
+      FreSnp(par, tun);
       return(0);
    }
 
-   // Set and count dependency bit
-   wrk = &typ1->SmlWrkTab[ (idx1-1) / typ1->SmlWrkSiz ];
-
-   if(!SetBit(wrk->DepWrdTab, (idx2-1) / typ1->DepWrkSiz ))
-      wrk->NmbDep++;
+   memcpy(tun->SnpWrkTab, typ1->SmlWrkTab, typ1->NmbSmlWrk * sizeof(WrkSct));
+   memcpy(tun->SnpDepMat, typ1->DepWrdMat, NmbWrd * sizeof(int));
+   tun->SnpNmbSml = typ1->NmbSmlWrk;
+   tun->SnpSmlSiz = typ1->SmlWrkSiz;
+   tun->SnpNmbWrd = typ1->NmbDepWrd;
+   tun->SnpDepSiz = typ1->DepWrkSiz;
+   tun->SnpSiz = typ1->NmbSmlWrk * sizeof(WrkSct) + NmbWrd * sizeof(int);
+   UpdMem(par, tun->TypIdx1);
 
-   return(wrk->NmbDep);
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Same as above, without any pre-checking of data                            */
+/* Restore a type's blocks from a snapshot and release it                     */
 /*----------------------------------------------------------------------------*/
 
-void UpdateDependencyFast( int64_t ParIdx,  int TypIdx1, int NmbTyp1,
-                           itg *TabIdx1, int TypIdx2, int NmbTyp2,
-                           itg *TabIdx2 )
+static void RstSnp(ParSct *par, TunSct *tun)
 {
-   int i, j;
-   ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ1 = &par->TypTab[ TypIdx1 ];
-   WrkSct *wrk;
-   (void)(TypIdx2);
+   TypSct *typ1 = &par->TypTab[ tun->TypIdx1 ];
 
-   for(i=0;i<NmbTyp1;i++)
-   {
-      wrk = &typ1->SmlWrkTab[ (TabIdx1[i] - 1) / typ1->SmlWrkSiz ];
+   if(!tun->SnpWrkTab)
+      return;
 
-      for(j=0;j<NmbTyp2;j++)
-         if( !SetBit(wrk->DepWrdTab, (TabIdx2[j] - 1) / typ1->DepWrkSiz ) )
-            wrk->NmbDep++;
+   memcpy(typ1->SmlWrkTab, tun->SnpWrkTab, tun->SnpNmbSml * sizeof(WrkSct));
+   memcpy(typ1->DepWrdMat, tun->SnpDepMat, (int64_t)typ1->MaxDepRow
+         * typ1->DepWrdStr * sizeof(int));
+
+   if(tun->phs == TunSml)
+   {
+      typ1->SmlLvl--;
+      typ1->CstShf--;
    }
+   else
+      typ1->DepLvl--;
+
+   typ1->NmbSmlWrk = tun->SnpNmbSml;
+   typ1->SmlWrkSiz = tun->SnpSmlSiz;
+   typ1->NmbDepWrd = tun->SnpNmbWrd;
+   typ1->DepWrkSiz = tun->SnpDepSiz;
+   ChgWrk(typ1);
+   FreSnp(par, tun);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Sort wp depending on their number of dependencies                          */
+/* Free a tuning snapshot                                                     */
 /*----------------------------------------------------------------------------*/
 
-int EndDependency(int64_t ParIdx, float DepSta[2])
+static void FreSnp(ParSct *par, TunSct *tun)
 {
-   int      i, NmbDepBit, TotNmbDep = 0;
-   ParSct   *par = (ParSct *)ParIdx;
-   TypSct   *typ1, *typ2;
+   if(tun->SnpWrkTab)
+      LPL_free(par->lmb, tun->SnpWrkTab);
 
-   // Get and check lib parallel instance
-   if( !ParIdx || !DepSta )
-      return(0);
+   if(tun->SnpDepMat)
+      LPL_free(par->lmb, tun->SnpDepMat);
 
-   // Compute average number of collisions
-   DepSta[1] = 0.;
-   typ1 = par->CurTyp;
-   typ2 = par->DepTyp;
+   tun->SnpWrkTab = NULL;
+   tun->SnpDepMat = NULL;
+   tun->SnpSiz = 0;
+}
 
-   if(!typ1 || !typ2 || !typ1->DepWrkSiz)
-      return(0);
 
-   for(i=0;i<typ1->NmbSmlWrk;i++)
-   {
-      TotNmbDep += typ1->SmlWrkTab[i].NmbDep;
-      typ1->SmlWrkTab[i].rnd = rand();
+/*----------------------------------------------------------------------------*/
+/* Write the frozen tuning settings to a text file                            */
+/*----------------------------------------------------------------------------*/
 
-      if(typ1->SmlWrkTab[i].NmbDep > DepSta[1])
-         DepSta[1] = (float)typ1->SmlWrkTab[i].NmbDep;
-   }
+int SaveTuning(int64_t ParIdx, char *FilNam)
+{
+   int      i, NmbTun = 0;
+   FILE     *hdl;
+   TunSct   *tun;
+   ParSct   *par = (ParSct *)ParIdx;
 
-   if(!TotNmbDep)
+   // Get and check lib parallel instance and file name
+   if(!ParIdx || !FilNam || !(hdl = fopen(FilNam, "w")))
       return(0);
 
-   DepSta[0] = (float)TotNmbDep;
+   fprintf(hdl, "LPlibTuning %d\n", par->NmbCpu);
 
-   // Compute stats
-   if(typ2->NmbLin >= typ1->DepWrkSiz)
+   for(i=0;i<par->NmbTun;i++)
    {
-      NmbDepBit = typ2->NmbLin / typ1->DepWrkSiz;
-
-      if(typ2->NmbLin - NmbDepBit * typ1->DepWrkSiz)
-         NmbDepBit++;
-   }
-   else
-      NmbDepBit = 1;
+      tun = &par->TunTab[i];
 
-   if(!NmbDepBit)
-      return(0);
+      if(tun->phs != TunEnd)
+         continue;
 
-   DepSta[0] = 100 * DepSta[0] / (typ1->NmbSmlWrk * NmbDepBit);
-   DepSta[1] = 100 * DepSta[1] / NmbDepBit;
+      fprintf(hdl, "%d %d %lld %lld %d %d %d %d %d %d\n",
+               tun->TypIdx1, tun->TypIdx2, (long long)tun->NmbLin1,
+               (long long)tun->NmbLin2, tun->rnk, tun->NmbPth, tun->NmbItl,
+               tun->SrtFlg, tun->SmlLvl, tun->DepLvl );
 
-   // Sort WP from highest collision number to the lowest
-   if(par->WrkSizSrt && par->DynSch)
-      qsort(typ1->SmlWrkTab, typ1->NmbSmlWrk, sizeof(WrkSct), CmpWrk);
+      NmbTun++;
+   }
 
-   // If the dynamic scheduling is disabled, set static WP
-   if(!par->DynSch && !SetGrp(par, typ1))
-      return(0);
+   fclose(hdl);
 
-   return(1);
+   return(NmbTun);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Sort wp depending on their number of dependencies                          */
+/* Read frozen tuning settings, they are bound to procedures at launch time   */
 /*----------------------------------------------------------------------------*/
 
-void GetDependencyStats(int64_t ParIdx, int TypIdx1,
-                        int TypIdx2, float DepSta[2])
+int LoadTuning(int64_t ParIdx, char *FilNam)
 {
-   int i, NmbDepBit, TotNmbDep = 0;
-   ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ1, *typ2;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return;
-
-   // Check bounds
-   typ1 = &par->TypTab[ TypIdx1 ];
-   typ2 = &par->TypTab[ TypIdx2 ];
+   int         NmbCpu, NmbTun = 0;
+   long long   NmbLin1, NmbLin2;
+   FILE        *hdl;
+   TunSct      *tun;
+   ParSct      *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance and file name
+   if(!ParIdx || !FilNam || !(hdl = fopen(FilNam, "r")))
+      return(0);
 
-   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
-   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
-   ||  !typ2->NmbLin )
+   // Settings found with another number of threads are meaningless
+   if( (fscanf(hdl, "LPlibTuning %d", &NmbCpu) != 1) || (NmbCpu != par->NmbCpu) )
    {
-      return;
+      fclose(hdl);
+      return(0);
    }
 
-   // Compute average number of collisions
-   DepSta[1] = 0.;
-
-   for(i=0;i<typ1->NmbSmlWrk;i++)
+   while(par->NmbTun < MaxTun)
    {
-      TotNmbDep += typ1->SmlWrkTab[i].NmbDep;
-
-      if(typ1->SmlWrkTab[i].NmbDep > DepSta[1])
-         DepSta[1] = (float)typ1->SmlWrkTab[i].NmbDep;
-   }
-
-   DepSta[0] = (float)TotNmbDep;
+      tun = &par->TunTab[ par->NmbTun ];
+      memset(tun, 0, sizeof(TunSct));
 
-   // Compute stats
-   if(typ2->NmbLin >= typ1->DepWrkSiz)
-   {
-      NmbDepBit = typ2->NmbLin / typ1->DepWrkSiz;
+      if(fscanf(hdl, "%d %d %lld %lld %d %d %d %d %d %d",
+               &tun->TypIdx1, &tun->TypIdx2, &NmbLin1, &NmbLin2, &tun->rnk,
+               &tun->NmbPth, &tun->NmbItl, &tun->SrtFlg, &tun->SmlLvl,
+               &tun->DepLvl ) != 10)
+      {
+         break;
+      }
 
-      if(typ2->NmbLin - NmbDepBit * typ1->DepWrkSiz)
-         NmbDepBit++;
+      tun->NmbLin1 = (itg)NmbLin1;
+      tun->NmbLin2 = (itg)NmbLin2;
+      tun->NmbPth = MAX(1, MIN(tun->NmbPth, par->NmbCpu));
+      tun->NmbItl = MAX(1, MIN(tun->NmbItl, MaxTunItl));
+      tun->phs = TunEnd;
+      par->NmbTun++;
+      NmbTun++;
    }
-   else
-      NmbDepBit = 1;
 
-   DepSta[0] = 100 * DepSta[0] / (typ1->NmbSmlWrk * NmbDepBit);
-   DepSta[1] = 100 * DepSta[1] / NmbDepBit;
+   fclose(hdl);
+
+   return(NmbTun);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Halve the number of small blocks by compining pairs of consecutive blocks  */
+/* Pthread handler, waits for job, does it, then signal end                   */
 /*----------------------------------------------------------------------------*/
 
-int HalveSmallBlocks(int64_t ParIdx, int TypIdx1, int TypIdx2)
+static void *PthHdl(void *ptr)
 {
-   int i, j;
-   ParSct *par = (ParSct *)ParIdx;
-   WrkSct *EvnWrk, *OddWrk, *NewWrk;
-   TypSct *typ1, *typ2;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(0);
+   itg i;
+   double tim = 0.;
+   PthSct *pth = (PthSct *)ptr;
+   ParSct *par = pth->par;
 
-   // Check bounds
-   typ1 = &par->TypTab[ TypIdx1 ];
-   typ2 = &par->TypTab[ TypIdx2 ];
+   // Tell the scheduler if all threads are ready
+   pthread_mutex_lock(&par->ParMtx);
+   par->WrkCpt++;
+   pthread_cond_signal(&par->ParCnd);
+   pthread_mutex_lock(&pth->mtx);
+   pthread_mutex_unlock(&par->ParMtx);
 
-   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
-   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
-   ||  !typ2->NmbLin )
+   // Enter main loop until StopParallel is send
+   do
    {
-      return(0);
-   }
+      // Wait for a wake-up signal from the main loop
+      pthread_cond_wait(&pth->cnd, &pth->mtx);
 
-   // Do not halve the number of blocks if there is only one left
-   // nor if the small blocks have been sorted
-   if(typ1->NmbSmlWrk < 2 || par->WrkSizSrt)
-      return(0);
+      // Pass the wake-up along the tree before running its own part,
+      // the concurrency of such launches being the team's size
+      if(par->TreWak)
+         WakSon(par, pth);
+      else
+      {
+         // Update this thread's own stats, summed up at the end of the loop
+         pth->sta[0]++;
+
+         for(i=0;i<par->NmbCpu;i++)
+            if(par->PthTab[i].wrk)
+               pth->sta[1]++;
+      }
+
+      switch(par->cmd)
+      {
+         // Call user's procedure with big WP
+         case RunBigWrk :
+         {
+            RunBig(par, pth);
+            EndTre(par, pth);
+         }break;
+
+         // Call user's procedure with small WP using dynamic scheduling
+         case RunSmlWrk :
+         {
+            do
+            {
+               // Time the WP if its type has an adaptive tree of blocks
+               if(par->typ1->NodTab)
+                  tim = GetWallClock();
+
+               // Run the WP
+               CalPrc(par, pth->wrk->BegIdx, pth->wrk->EndIdx, pth->idx);
+
+               if(par->typ1->NodTab)
+                  par->typ1->NodTab[ pth->wrk->NodIdx ].RunTim = GetWallClock() - tim;
+
+               // Locked acces to global parameters: 
+               // update WP count, tag WP done and signal the main loop
+               pthread_mutex_lock(&par->ParMtx);
+
+               par->WrkCpt++;
+
+               if(!(pth->wrk = NexWrk(par, pth->idx)))
+               {
+                  par->req = 1;
+                  pthread_cond_signal(&par->ParCnd);
+                  pthread_mutex_unlock(&par->ParMtx);
+                  break;
+               }
+
+               if(par->req)
+                  pthread_cond_signal(&par->ParCnd);
+
+               pthread_mutex_unlock(&par->ParMtx);
+            }while(1);
+         }break;
+
+         // Replay a recorded dynamic schedule of small WP
+         case RunRplWrk :
+         {
+            RunRpl(par, pth);
+            EndTre(par, pth);
+         }break;
+
+         // Run a stretch of a captured graph
+         case RunGrfWrk :
+         {
+            RunGrf(par, pth);
+            EndTre(par, pth);
+         }break;
+
+         // Call user's procedure with small WP using dynamic scheduling
+         case RunGrnWrk :
+         {
+            do
+            {
+               // Run the WP
+               CalPrc(par, pth->wrk->BegIdx, pth->wrk->EndIdx, GetGrnIdx(par, pth->wrk));
+
+               // Locked acces to global parameters: 
+               // update WP count, tag WP done and signal the main loop
+               pthread_mutex_lock(&par->ParMtx);
+
+               par->WrkCpt++;
+
+               if(!(pth->wrk = NexGrn(par, pth->idx)))
+               {
+                  par->req = 1;
+                  pthread_cond_signal(&par->ParCnd);
+                  pthread_mutex_unlock(&par->ParMtx);
+                  break;
+               }
+
+               if(par->req)
+                  pthread_cond_signal(&par->ParCnd);
+
+               pthread_mutex_unlock(&par->ParMtx);
+            }while(1);
+         }break;
+
+         // Call user's procedure with small WP using static scheduling
+         case RunDetWrk :
+         {
+            RunDet(par, pth);
+            EndTre(par, pth);
+         }break;
+
+         case ClrMem :
+         {
+            // Clear memory and signal completion to the scheduler
+            ClrKer(pth->ClrAdr, pth->ClrMemSiz, par->MemStr);
+            EndTre(par, pth);
+         }break;
+
+         case CpyMem :
+         {
+            // Copy memory and signal completion to the scheduler
+            CpyKer(pth->DstAdr, pth->SrcAdr, pth->CpyMemSiz, par->MemStr);
+            EndTre(par, pth);
+         }break;
+
+         case SetMem :
+         {
+            // Fill memory with a pattern and signal completion to the scheduler
+            SetKer(pth->DstAdr, pth->CpyMemSiz, pth->SrcAdr, par->PatSiz, par->MemStr);
+            EndTre(par, pth);
+         }break;
+
+         case EndPth :
+         {
+            // Destroy the thread mutex and condition and call for join
+            pthread_mutex_unlock(&pth->mtx);
+            pthread_mutex_destroy(&pth->mtx);
+            pthread_cond_destroy(&pth->cnd);
+            return(NULL);
+         }break;
+      }
+   }while(1);
+
+   return(NULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run a thread's big WP, possibly split into interleaved blocks              */
+/*----------------------------------------------------------------------------*/
+
+static void RunBig(ParSct *par, PthSct *pth)
+{
+   int i;
+   itg beg, end;
+
+   for(i=0;i<par->NmbItlBlk;i++)
+   {
+      beg = pth->big->ItlTab[i][0];
+      end = pth->big->ItlTab[i][1];
+
+      if(!beg || !end || (end < beg))
+         continue;
+
+      if(par->clk)
+         pth->big->RunTim = GetWallClock();
+
+      CalPrc(par, beg, end, pth->idx);
+
+      if(par->clk)
+         pth->big->RunTim = GetWallClock() - pth->big->RunTim;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run a thread's part of every static group in turn, only waiting for the   */
+/* parts of former groups it conflicts with                                   */
+/*----------------------------------------------------------------------------*/
+
+static void RunDet(ParSct *par, PthSct *pth)
+{
+   int      i, GrpIdx, *WaiTab;
+   itg      beg, end;
+   GrpSct   *grp;
+
+   for(grp = par->typ1->NexGrp, GrpIdx = 1; grp; grp = grp->nex, GrpIdx++)
+   {
+      // Wait for the conflicting parts of former groups run
+      // by other threads to be completed
+      WaiTab = &grp->WaiTab[ pth->idx * par->NmbCpu ];
+      pthread_mutex_lock(&par->GrpMtx);
+
+      for(i=0;i<par->NmbCpu;i++)
+         while(par->PthTab[i].DonGrp < WaiTab[i])
+            pthread_cond_wait(&par->GrpCnd, &par->GrpMtx);
+
+      pthread_mutex_unlock(&par->GrpMtx);
+
+      // Loop over the group's WP
+      for(i=0;i<grp->NmbSmlWrk[ pth->idx ];i++)
+      {
+         beg = grp->SmlWrkTab[ pth->idx ][i]->BegIdx;
+         end = grp->SmlWrkTab[ pth->idx ][i]->EndIdx;
+
+         CalPrc(par, beg, end, pth->idx);
+      }
+
+      // Publish this thread's progress
+      pthread_mutex_lock(&par->GrpMtx);
+      pth->DonGrp = GrpIdx;
+      pthread_cond_broadcast(&par->GrpCnd);
+      pthread_mutex_unlock(&par->GrpMtx);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run a thread's list of a recorded dynamic schedule                         */
+/*----------------------------------------------------------------------------*/
+
+static void RunRpl(ParSct *par, PthSct *pth)
+{
+   int      i, j, RplIdx;
+   double   tim = 0.;
+   TypSct   *typ = par->typ1;
+   WrkSct   *wrk;
+
+   for(i=typ->RplOff[ pth->idx ]; i<typ->RplOff[ pth->idx + 1 ]; i++)
+   {
+      RplIdx = typ->RplWrk[i];
+      wrk = &typ->SmlWrkTab[ typ->RplSeq[ RplIdx ] ];
+
+      // Wait for the conflicting WP recorded before this one
+      // and run by other threads
+      if(typ->RplPreOff[ RplIdx ] < typ->RplPreOff[ RplIdx + 1 ])
+      {
+         pthread_mutex_lock(&par->GrpMtx);
+
+         for(j=typ->RplPreOff[ RplIdx ]; j<typ->RplPreOff[ RplIdx + 1 ]; j++)
+            while(typ->RplDon[ typ->RplPreTab[j] ] != typ->RplEpo)
+            {
+               par->RplWai++;
+               pthread_cond_wait(&par->GrpCnd, &par->GrpMtx);
+               par->RplWai--;
+            }
+
+         pthread_mutex_unlock(&par->GrpMtx);
+      }
+
+      if(typ->NodTab)
+         tim = GetWallClock();
+
+      CalPrc(par, wrk->BegIdx, wrk->EndIdx, pth->idx);
+
+      if(typ->NodTab)
+         typ->NodTab[ wrk->NodIdx ].RunTim = GetWallClock() - tim;
+
+      // Flag the WP as done and only wake up the waiting threads
+      pthread_mutex_lock(&par->GrpMtx);
+      typ->RplDon[ RplIdx ] = typ->RplEpo;
+
+      if(par->RplWai)
+         pthread_cond_broadcast(&par->GrpCnd);
+
+      pthread_mutex_unlock(&par->GrpMtx);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Get the next WP to be computed                                             */
+/*----------------------------------------------------------------------------*/
+
+static WrkSct *NexWrk(ParSct *par, int PthIdx)
+{
+   TypSct *typ = par->typ1;
+   WrkSct *wrk;
+
+   if(typ->OrdDep)
+      wrk = NexOrd(par, PthIdx);
+   else if(par->AffSch && typ->AffTab)
+      wrk = NexAff(par, PthIdx);
+   else
+      wrk = NexBuf(par, PthIdx);
+
+   // Record the order in which WP are handed to threads
+   if(wrk && typ->RplRec)
+   {
+      wrk->PthIdx = PthIdx;
+      typ->RplSeq[ typ->NmbRpl++ ] = (int)(wrk - typ->SmlWrkTab);
+   }
+
+   return(wrk);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Get the next WP from the buffer of compatible WP, filling it if empty      */
+/*----------------------------------------------------------------------------*/
+
+static WrkSct *NexBuf(ParSct *par, int PthIdx)
+{
+   PthSct *pth = &par->PthTab[ PthIdx ];
+   WrkSct *wrk;
+
+   // Remove previous work's tags
+   if(pth->wrk)
+      SubWrd(par->typ1->NmbDepWrd, pth->wrk->DepWrdTab, par->typ1->RunDepTab);
+
+   // If the wp's buffer is empty search for some new compatible wp to fill in
+   if(!par->BufCpt)
+   {
+      wrk = par->NexWrk;
+
+      while(wrk)
+      {
+         // Check for dependencies
+         if(!AndWrd(par->typ1->NmbDepWrd, wrk->DepWrdTab, par->typ1->RunDepTab))
+         {
+            par->BufWrk[ par->BufCpt++ ] = wrk;
+
+            // Unlink wp
+            if(wrk->pre)
+               wrk->pre->nex = wrk->nex;
+            else
+               par->NexWrk = wrk->nex;
+
+            if(wrk->nex)
+               wrk->nex->pre = wrk->pre;
+
+            // Add new work's tags
+            AddWrd(par->typ1->NmbDepWrd, wrk->DepWrdTab, par->typ1->RunDepTab);
+
+            if(par->BufCpt == par->BufMax)
+               break;
+         }
+
+         wrk = wrk->nex;
+      }
+   }
+
+   // Return the next available wp in buffer and unlink it from the todo list
+   return(par->BufCpt ? par->BufWrk[ --par->BufCpt ] : NULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Give each thread back the WP it ran during the previous launch of this     */
+/* type, in the same order, the other ones are put in the shared list         */
+/*----------------------------------------------------------------------------*/
+
+static int SetAffLst(ParSct *par, TypSct *typ)
+{
+   int      i, j, SmlIdx, NmbAff = typ->NmbAff;
+   WrkSct   *wrk, **LstWrk = par->PthWrk, *pre = NULL;
+
+   // Adaptive WP are made of one or more leaves of the tree
+   typ->NmbSlt = typ->NodTab ? MAX(typ->NmbLef, typ->NmbSmlWrk) : typ->NmbSmlWrk;
+
+   if(typ->MaxAff < typ->NmbSlt)
+   {
+      if(typ->AffTab)
+         LPL_free(par->lmb, typ->AffTab);
+
+      if(typ->AffSlt)
+         LPL_free(par->lmb, typ->AffSlt);
+
+      typ->MaxAff = typ->NmbSlt * par->SizMul;
+      NmbAff = 0;
+      typ->AffTab = LPL_malloc(par->lmb, typ->MaxAff * sizeof(WrkSct *));
+      typ->AffSlt = LPL_malloc(par->lmb, typ->MaxAff * sizeof(int));
+
+      if(!typ->AffTab || !typ->AffSlt)
+      {
+         if(typ->AffTab)
+            LPL_free(par->lmb, typ->AffTab);
+
+         if(typ->AffSlt)
+            LPL_free(par->lmb, typ->AffSlt);
+
+         typ->AffTab = NULL;
+         typ->AffSlt = NULL;
+         typ->MaxAff = typ->NmbAff = 0;
+         return(0);
+      }
+   }
+
+   // WP may be sorted by number of dependencies, so the slot of the WP
+   // holding a given line is found through its index order position.
+   // Only the first and last positions of an adaptive WP are looked for
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      wrk = &typ->SmlWrkTab[i];
+      wrk->LstIdx = -1;
+
+      if( (wrk->BegIdx < 1) || (wrk->EndIdx < wrk->BegIdx) || (wrk->EndIdx > typ->NmbLin) )
+         continue;
+
+      for(j=0;j<2;j++)
+      {
+         SmlIdx = GetSmlIdx(typ, j ? wrk->EndIdx : wrk->BegIdx);
+
+         if( (SmlIdx >= 0) && (SmlIdx < typ->NmbSlt) )
+            typ->AffSlt[ SmlIdx ] = i;
+      }
+   }
+
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      par->PthTab[i].AffWrk = LstWrk[i] = NULL;
+   }
+
+   // WP are recorded in the order they were taken, so each thread's list
+   // keeps its former order, records made stale by a change of the blocks
+   // only alter the partition as every WP is linked once
+   for(i=0;i<NmbAff;i++)
+   {
+      wrk = typ->AffTab[i];
+
+      if( (wrk < typ->SmlWrkTab) || (wrk >= typ->SmlWrkTab + typ->NmbSmlWrk)
+      ||  (wrk->LstIdx != -1) || (wrk->PthIdx < 0) || (wrk->PthIdx >= par->NmbCpu) )
+      {
+         continue;
+      }
+
+      wrk->LstIdx = wrk->PthIdx;
+      wrk->pre = LstWrk[ wrk->PthIdx ];
+      wrk->nex = NULL;
+
+      if(wrk->pre)
+         wrk->pre->nex = wrk;
+      else
+         par->PthTab[ wrk->PthIdx ].AffWrk = wrk;
+
+      LstWrk[ wrk->PthIdx ] = wrk;
+   }
+
+   // The remaining WP, all of them on the first launch, are shared
+   par->NexWrk = NULL;
+
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      wrk = &typ->SmlWrkTab[i];
+
+      if(wrk->LstIdx != -1)
+         continue;
+
+      wrk->LstIdx = par->NmbCpu;
+      wrk->pre = pre;
+      wrk->nex = NULL;
+
+      if(pre)
+         pre->nex = wrk;
+      else
+         par->NexWrk = wrk;
+
+      pre = wrk;
+   }
+
+   typ->NmbAff = 0;
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Get the next WP to be computed with cache affinity: the one following the  */
+/* last completed WP, then the thread's own WP, the shared ones and at last   */
+/* the other threads' WP                                                      */
+/*----------------------------------------------------------------------------*/
+
+static WrkSct *NexAff(ParSct *par, int PthIdx)
+{
+   int      i, LstIdx, SmlIdx;
+   itg      NgbIdx[2];
+   PthSct   *pth = &par->PthTab[ PthIdx ];
+   TypSct   *typ = par->typ1;
+   WrkSct   *wrk = pth->wrk;
+
+   if(wrk)
+   {
+      // Remove previous work's tags
+      SubWrd(typ->NmbDepWrd, wrk->DepWrdTab, typ->RunDepTab);
+
+      // Look for a pending neighbour in index (or Hilbert) order:
+      // the WP holding the lines right after and before the last one
+      NgbIdx[0] = wrk->EndIdx + 1;
+      NgbIdx[1] = wrk->BegIdx - 1;
+
+      for(i=0;i<2;i++)
+      {
+         if( (NgbIdx[i] < 1) || (NgbIdx[i] > typ->NmbLin) )
+            continue;
+
+         SmlIdx = GetSmlIdx(typ, NgbIdx[i]);
+
+         if( (SmlIdx < 0) || (SmlIdx >= typ->NmbSlt)
+         ||  (typ->AffSlt[ SmlIdx ] < 0) || (typ->AffSlt[ SmlIdx ] >= typ->NmbSmlWrk) )
+         {
+            continue;
+         }
+
+         wrk = &typ->SmlWrkTab[ typ->AffSlt[ SmlIdx ] ];
+
+         if( ((wrk->LstIdx == PthIdx) || (wrk->LstIdx == par->NmbCpu))
+         &&  ( (wrk->BegIdx == pth->wrk->EndIdx + 1)
+            || (wrk->EndIdx + 1 == pth->wrk->BegIdx) )
+         &&  !AndWrd(typ->NmbDepWrd, wrk->DepWrdTab, typ->RunDepTab) )
+         {
+            return(TakAff(par, wrk, PthIdx));
+         }
+      }
+   }
+
+   // Then the first compatible WP of the thread's own list and the shared one
+   for(wrk = pth->AffWrk; wrk; wrk = wrk->nex)
+      if(!AndWrd(typ->NmbDepWrd, wrk->DepWrdTab, typ->RunDepTab))
+         return(TakAff(par, wrk, PthIdx));
+
+   for(wrk = par->NexWrk; wrk; wrk = wrk->nex)
+      if(!AndWrd(typ->NmbDepWrd, wrk->DepWrdTab, typ->RunDepTab))
+         return(TakAff(par, wrk, PthIdx));
+
+   // Steal from the other threads as a last resort, starting from the end
+   // of their lists that they will reach last
+   for(i=1;i<par->NmbCpu;i++)
+   {
+      LstIdx = (PthIdx + i) % par->NmbCpu;
+
+      if(!(wrk = par->PthTab[ LstIdx ].AffWrk))
+         continue;
+
+      while(wrk->nex)
+         wrk = wrk->nex;
+
+      for(; wrk; wrk = wrk->pre)
+         if(!AndWrd(typ->NmbDepWrd, wrk->DepWrdTab, typ->RunDepTab))
+            return(TakAff(par, wrk, PthIdx));
+   }
+
+   return(NULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Unlink a WP from its list, tag it as running and record its new owner      */
+/*----------------------------------------------------------------------------*/
+
+static WrkSct *TakAff(ParSct *par, WrkSct *wrk, int PthIdx)
+{
+   TypSct *typ = par->typ1;
+
+   if(wrk->pre)
+      wrk->pre->nex = wrk->nex;
+   else if(wrk->LstIdx == par->NmbCpu)
+      par->NexWrk = wrk->nex;
+   else
+      par->PthTab[ wrk->LstIdx ].AffWrk = wrk->nex;
+
+   if(wrk->nex)
+      wrk->nex->pre = wrk->pre;
+
+   AddWrd(typ->NmbDepWrd, wrk->DepWrdTab, typ->RunDepTab);
+   wrk->LstIdx = -1;
+   wrk->PthIdx = PthIdx;
+
+   if(typ->NmbAff < typ->MaxAff)
+      typ->AffTab[ typ->NmbAff++ ] = wrk;
+
+   return(wrk);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate the record of a type's dynamic schedule                           */
+/*----------------------------------------------------------------------------*/
+
+static int AlcRpl(ParSct *par, TypSct *typ)
+{
+   FreRpl(par, typ);
+
+   if(!(typ->RplSeq = LPL_malloc(par->lmb, typ->NmbSmlWrk * sizeof(int))))
+      return(0);
+
+   typ->RplSiz = typ->NmbSmlWrk * sizeof(int);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Split the recorded sequence of WP into per-thread lists and give each WP   */
+/* the last WP recorded before it, on another thread, for each of its bits    */
+/*----------------------------------------------------------------------------*/
+
+static int SetRpl(ParSct *par, TypSct *typ)
+{
+   int      i, j, k, b, p, n = typ->NmbSmlWrk, NmbBit = typ->NmbDepWrd * 32;
+   int      NmbPre = 0, *LstRpl = NULL, *MrkRpl = NULL, res = 0;
+   WrkSct   *wrk;
+
+   // A launch stopped short leaves an incomplete record
+   if(typ->NmbRpl != n)
+      goto RplEnd;
+
+   for(i=0;i<n;i++)
+      NmbPre += typ->SmlWrkTab[i].NmbDep;
+
+   typ->RplOff = LPL_calloc(par->lmb, par->NmbCpu + 1, sizeof(int));
+   typ->RplWrk = LPL_malloc(par->lmb, n * sizeof(int));
+   typ->RplPreOff = LPL_malloc(par->lmb, (n + 1) * sizeof(int));
+   typ->RplPreTab = LPL_malloc(par->lmb, (NmbPre + 1) * sizeof(int));
+   typ->RplDon = LPL_calloc(par->lmb, n, sizeof(int));
+   LstRpl = LPL_malloc(par->lmb, NmbBit * sizeof(int));
+   MrkRpl = LPL_malloc(par->lmb, n * sizeof(int));
+
+   if( !typ->RplOff || !typ->RplWrk || !typ->RplPreOff || !typ->RplPreTab
+   ||  !typ->RplDon || !LstRpl || !MrkRpl )
+   {
+      goto RplEnd;
+   }
+
+   // Each thread's list keeps the recorded order
+   for(k=0;k<n;k++)
+      typ->RplOff[ typ->SmlWrkTab[ typ->RplSeq[k] ].PthIdx + 1 ]++;
+
+   for(i=0;i<par->NmbCpu;i++)
+      typ->RplOff[ i+1 ] += typ->RplOff[i];
+
+   for(k=0;k<n;k++)
+      typ->RplWrk[ typ->RplOff[ typ->SmlWrkTab[ typ->RplSeq[k] ].PthIdx ]++ ] = k;
+
+   for(i=par->NmbCpu;i>0;i--)
+      typ->RplOff[i] = typ->RplOff[ i-1 ];
+
+   typ->RplOff[0] = 0;
+
+   // WP sharing a bit ran one after the other, so waiting for the last one
+   // is enough, and a thread's own WP are run in order anyway
+   for(i=0;i<NmbBit;i++)
+      LstRpl[i] = -1;
+
+   for(k=0;k<n;k++)
+      MrkRpl[k] = -1;
+
+   typ->RplPreOff[0] = 0;
+
+   for(k=0;k<n;k++)
+   {
+      wrk = &typ->SmlWrkTab[ typ->RplSeq[k] ];
+      typ->RplPreOff[ k+1 ] = typ->RplPreOff[k];
+
+      for(j=0;j<typ->NmbDepWrd;j++)
+      {
+         if(!wrk->DepWrdTab[j])
+            continue;
+
+         for(b=j*32; b<(j+1)*32; b++)
+         {
+            if(!GetBit(wrk->DepWrdTab, b))
+               continue;
+
+            p = LstRpl[b];
+            LstRpl[b] = k;
+
+            if( (p < 0) || (MrkRpl[p] == k)
+            ||  (typ->SmlWrkTab[ typ->RplSeq[p] ].PthIdx == wrk->PthIdx) )
+            {
+               continue;
+            }
+
+            MrkRpl[p] = k;
+            typ->RplPreTab[ typ->RplPreOff[ k+1 ]++ ] = p;
+         }
+      }
+   }
+
+   typ->RplSiz += (par->NmbCpu + 3 * n + NmbPre + 3) * sizeof(int);
+   UpdMem(par, (int)(typ - par->TypTab));
+   res = 1;
+
+   RplEnd:
+
+   if(LstRpl)
+      LPL_free(par->lmb, LstRpl);
+
+   if(MrkRpl)
+      LPL_free(par->lmb, MrkRpl);
+
+   // A schedule that could not be derived is not kept, even partially
+   if(!res)
+      FreRpl(par, typ);
+
+   return(res);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free a type's recorded schedule                                            */
+/*----------------------------------------------------------------------------*/
+
+static void FreRpl(ParSct *par, TypSct *typ)
+{
+   if(typ->RplSeq)
+      LPL_free(par->lmb, typ->RplSeq);
+
+   if(typ->RplOff)
+      LPL_free(par->lmb, typ->RplOff);
+
+   if(typ->RplWrk)
+      LPL_free(par->lmb, typ->RplWrk);
+
+   if(typ->RplPreOff)
+      LPL_free(par->lmb, typ->RplPreOff);
+
+   if(typ->RplPreTab)
+      LPL_free(par->lmb, typ->RplPreTab);
+
+   if(typ->RplDon)
+      LPL_free(par->lmb, typ->RplDon);
+
+   typ->RplSeq = typ->RplOff = typ->RplWrk = NULL;
+   typ->RplPreOff = typ->RplPreTab = typ->RplDon = NULL;
+   typ->RplTyp = typ->RplRec = typ->NmbRpl = 0;
+   typ->RplSiz = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* The small WP or their dependencies changed: the schedules derived from     */
+/* them will have to be rebuilt                                               */
+/*----------------------------------------------------------------------------*/
+
+static void ChgWrk(TypSct *typ)
+{
+   typ->RplTyp = 0;
+   typ->OrdUpd = 1;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build the precedence graph of ordered dependencies: a WP must run after    */
+/* the WP of lower indices sharing a dependency block with it, the previous   */
+/* user of each block being enough as it waited itself for the former ones    */
+/*----------------------------------------------------------------------------*/
+
+static int SetOrd(ParSct *par, TypSct *typ)
+{
+   int      i, j, b, p, w, n = typ->NmbSmlWrk, NmbBit = typ->NmbDepWrd * 32;
+   int      NmbEdg = 0, MaxEdg = 0, *LstWrk, *MrkWrk, (*EdgTab)[2];
+   WrkSct   *wrk, **WrkTab;
+
+   FreOrd(par, typ);
+
+   for(i=0;i<n;i++)
+      MaxEdg += typ->SmlWrkTab[i].NmbDep;
+
+   typ->OrdPre = LPL_calloc(par->lmb, n, sizeof(int));
+   typ->OrdCnt = LPL_malloc(par->lmb, n * sizeof(int));
+   typ->OrdQue = LPL_malloc(par->lmb, n * sizeof(int));
+   typ->OrdSucOff = LPL_calloc(par->lmb, n + 1, sizeof(int));
+   EdgTab = LPL_malloc(par->lmb, (MaxEdg + 1) * 2 * sizeof(int));
+   LstWrk = LPL_malloc(par->lmb, NmbBit * sizeof(int));
+   MrkWrk = LPL_malloc(par->lmb, n * sizeof(int));
+   WrkTab = LPL_malloc(par->lmb, n * sizeof(WrkSct *));
+
+   if( !typ->OrdPre || !typ->OrdCnt || !typ->OrdQue || !typ->OrdSucOff
+   ||  !EdgTab || !LstWrk || !MrkWrk || !WrkTab )
+   {
+      FreOrd(par, typ);
+
+      if(EdgTab)
+         LPL_free(par->lmb, EdgTab);
+
+      if(LstWrk)
+         LPL_free(par->lmb, LstWrk);
+
+      if(MrkWrk)
+         LPL_free(par->lmb, MrkWrk);
+
+      if(WrkTab)
+         LPL_free(par->lmb, WrkTab);
+
+      return(0);
+   }
+
+   // WP may have been sorted, the order is the one of their indices
+   for(i=0;i<n;i++)
+      WrkTab[i] = &typ->SmlWrkTab[i];
+
+   qsort(WrkTab, n, sizeof(WrkSct *), CmpPtr);
+
+   for(i=0;i<NmbBit;i++)
+      LstWrk[i] = -1;
+
+   for(i=0;i<n;i++)
+      MrkWrk[i] = -1;
+
+   for(i=0;i<n;i++)
+   {
+      wrk = WrkTab[i];
+      w = (int)(wrk - typ->SmlWrkTab);
+
+      for(j=0;j<typ->NmbDepWrd;j++)
+      {
+         if(!wrk->DepWrdTab[j])
+            continue;
+
+         for(b=j*32; b<(j+1)*32; b++)
+         {
+            if(!GetBit(wrk->DepWrdTab, b))
+               continue;
+
+            p = LstWrk[b];
+            LstWrk[b] = w;
+
+            if( (p < 0) || (MrkWrk[p] == w) )
+               continue;
+
+            MrkWrk[p] = w;
+            EdgTab[ NmbEdg ][0] = p;
+            EdgTab[ NmbEdg ][1] = w;
+            NmbEdg++;
+            typ->OrdPre[w]++;
+            typ->OrdSucOff[ p+1 ]++;
+         }
+      }
+   }
+
+   // Store the successors of each WP
+   for(i=0;i<n;i++)
+      typ->OrdSucOff[ i+1 ] += typ->OrdSucOff[i];
+
+   typ->OrdSucTab = LPL_malloc(par->lmb, (NmbEdg + 1) * sizeof(int));
+
+   if(typ->OrdSucTab)
+      for(i=0;i<NmbEdg;i++)
+         typ->OrdSucTab[ typ->OrdSucOff[ EdgTab[i][0] ]++ ] = EdgTab[i][1];
+
+   for(i=n;i>0;i--)
+      typ->OrdSucOff[i] = typ->OrdSucOff[ i-1 ];
+
+   typ->OrdSucOff[0] = 0;
+
+   // A WP's critical path is its number of lines plus the longest
+   // path of its successors, WP in decreasing indices being processed
+   // after all their successors
+   if(typ->PriTab)
+      SetPri(typ);
+   else if(typ->CrtPth && typ->OrdSucTab)
+      for(i=n-1;i>=0;i--)
+      {
+         wrk = WrkTab[i];
+         w = (int)(wrk - typ->SmlWrkTab);
+         wrk->pri = 0.;
+
+         for(j=typ->OrdSucOff[w]; j<typ->OrdSucOff[ w+1 ]; j++)
+            wrk->pri = MAX(wrk->pri, typ->SmlWrkTab[ typ->OrdSucTab[j] ].pri);
+
+         wrk->pri += (float)(wrk->EndIdx - wrk->BegIdx + 1);
+      }
+
+   LPL_free(par->lmb, EdgTab);
+   LPL_free(par->lmb, LstWrk);
+   LPL_free(par->lmb, MrkWrk);
+   LPL_free(par->lmb, WrkTab);
+
+   if(!typ->OrdSucTab)
+   {
+      FreOrd(par, typ);
+      return(0);
+   }
+
+   typ->OrdSiz = (4 * n + NmbEdg + 2) * sizeof(int);
+   typ->OrdUpd = 0;
+   UpdMem(par, (int)(typ - par->TypTab));
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Reset the predecessor counts and queue the WP without any                  */
+/*----------------------------------------------------------------------------*/
+
+static void RstOrd(TypSct *typ)
+{
+   int i;
+
+   typ->OrdHed = typ->OrdTal = 0;
+
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      typ->OrdCnt[i] = typ->OrdPre[i];
+
+      if(!typ->OrdPre[i])
+         PshOrd(typ, i);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Release the successors of the WP just completed and get the next ready WP  */
+/*----------------------------------------------------------------------------*/
+
+static WrkSct *NexOrd(ParSct *par, int PthIdx)
+{
+   int      i, w;
+   PthSct   *pth = &par->PthTab[ PthIdx ];
+   TypSct   *typ = par->typ1;
+
+   if(pth->wrk)
+   {
+      w = (int)(pth->wrk - typ->SmlWrkTab);
+
+      for(i=typ->OrdSucOff[w]; i<typ->OrdSucOff[ w+1 ]; i++)
+         if(!--typ->OrdCnt[ typ->OrdSucTab[i] ])
+            PshOrd(typ, typ->OrdSucTab[i]);
+   }
+
+   if(typ->OrdHed == typ->OrdTal)
+      return(NULL);
+
+   return(&typ->SmlWrkTab[ PopOrd(typ) ]);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Queue a ready WP: in arrival order or, with priorities, in a binary heap   */
+/* whose top is the ready WP of highest priority                              */
+/*----------------------------------------------------------------------------*/
+
+static void PshOrd(TypSct *typ, int w)
+{
+   int      i, f, *que = typ->OrdQue;
+   WrkSct   *wrk = typ->SmlWrkTab;
+
+   i = typ->OrdTal++;
+
+   if(!typ->CrtPth && !typ->PriTab)
+   {
+      que[i] = w;
+      return;
+   }
+
+   while(i > 0)
+   {
+      f = (i - 1) / 2;
+
+      if(wrk[ que[f] ].pri >= wrk[w].pri)
+         break;
+
+      que[i] = que[f];
+      i = f;
+   }
+
+   que[i] = w;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Get the next ready WP out of the queue or the heap                         */
+/*----------------------------------------------------------------------------*/
+
+static int PopOrd(TypSct *typ)
+{
+   int      i, s, w, top, *que = typ->OrdQue;
+   WrkSct   *wrk = typ->SmlWrkTab;
+
+   if(!typ->CrtPth && !typ->PriTab)
+      return(que[ typ->OrdHed++ ]);
+
+   // The heap always starts at OrdHed = 0
+   top = que[0];
+   w = que[ --typ->OrdTal ];
+   i = 0;
+
+   while( (s = 2 * i + 1) < typ->OrdTal )
+   {
+      if( (s + 1 < typ->OrdTal) && (wrk[ que[ s+1 ] ].pri > wrk[ que[s] ].pri) )
+         s++;
+
+      if(wrk[w].pri >= wrk[ que[s] ].pri)
+         break;
+
+      que[i] = que[s];
+      i = s;
+   }
+
+   que[i] = w;
+
+   return(top);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Give each small WP the priority of its critical work: the highest user     */
+/* priority among its lines or the longest chain of lines among the WP        */
+/* sharing one of its dependency blocks, as they must run one after another   */
+/*----------------------------------------------------------------------------*/
+
+static void SetPri(TypSct *typ)
+{
+   int      i, j, b;
+   itg      k;
+   WrkSct   *wrk;
+
+   if(typ->PriTab)
+   {
+      for(i=0;i<typ->NmbSmlWrk;i++)
+      {
+         wrk = &typ->SmlWrkTab[i];
+         wrk->pri = typ->PriTab[ wrk->BegIdx ];
+
+         for(k=wrk->BegIdx+1; k<=wrk->EndIdx; k++)
+            wrk->pri = MAX(wrk->pri, typ->PriTab[k]);
+      }
+
+      return;
+   }
+
+   // Ordered dependencies have their own critical path set by SetOrd()
+   if(!typ->CrtPth || !typ->PriBit || typ->OrdDep)
+      return;
+
+   for(b=0;b<typ->NmbDepWrd*32;b++)
+      typ->PriBit[b] = 0.;
+
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      wrk = &typ->SmlWrkTab[i];
+
+      for(j=0;j<typ->NmbDepWrd;j++)
+         if(wrk->DepWrdTab[j])
+            for(b=j*32; b<(j+1)*32; b++)
+               if(GetBit(wrk->DepWrdTab, b))
+                  typ->PriBit[b] += (float)(wrk->EndIdx - wrk->BegIdx + 1);
+   }
+
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      wrk = &typ->SmlWrkTab[i];
+      wrk->pri = 0.;
+
+      for(j=0;j<typ->NmbDepWrd;j++)
+         if(wrk->DepWrdTab[j])
+            for(b=j*32; b<(j+1)*32; b++)
+               if(GetBit(wrk->DepWrdTab, b))
+                  wrk->pri = MAX(wrk->pri, typ->PriBit[b]);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Static groups of ordered dependencies: the WP are leveled as a wavefront,  */
+/* each level's WP being independent, and levels are cut into groups         */
+/*----------------------------------------------------------------------------*/
+
+static int SetOrdGrp(ParSct *par, TypSct *typ)
+{
+   int      i, j, k, s, t, w, m, n = typ->NmbSmlWrk, NmbLvl = 0, NmbGrp = 0;
+   int      *LvlTab, *LvlOff, *OrdTab;
+   GrpSct   *grp, *LstGrp = NULL;
+
+   FreGrp(par, typ);
+
+   LvlTab = LPL_calloc(par->lmb, n, sizeof(int));
+   LvlOff = LPL_calloc(par->lmb, n + 1, sizeof(int));
+   OrdTab = LPL_malloc(par->lmb, n * sizeof(int));
+
+   if(!LvlTab || !LvlOff || !OrdTab)
+      return(0);
+
+   // Level each WP one above its highest predecessor
+   RstOrd(typ);
+
+   while(typ->OrdHed < typ->OrdTal)
+   {
+      w = typ->OrdQue[ typ->OrdHed++ ];
+      NmbLvl = MAX(NmbLvl, LvlTab[w] + 1);
+
+      for(i=typ->OrdSucOff[w]; i<typ->OrdSucOff[ w+1 ]; i++)
+      {
+         s = typ->OrdSucTab[i];
+         LvlTab[s] = MAX(LvlTab[s], LvlTab[w] + 1);
+
+         if(!--typ->OrdCnt[s])
+            typ->OrdQue[ typ->OrdTal++ ] = s;
+      }
+   }
+
+   // Sort the WP by level, keeping their order within each level
+   for(w=0;w<n;w++)
+      LvlOff[ LvlTab[w] + 1 ]++;
+
+   for(i=0;i<NmbLvl;i++)
+      LvlOff[ i+1 ] += LvlOff[i];
+
+   for(w=0;w<n;w++)
+      OrdTab[ LvlOff[ LvlTab[w] ]++ ] = w;
+
+   for(i=NmbLvl;i>0;i--)
+      LvlOff[i] = LvlOff[ i-1 ];
+
+   LvlOff[0] = 0;
+
+   // Share each level's WP among threads in consecutive chunks
+   for(i=0;i<NmbLvl;i++)
+      for(k=LvlOff[i]; k<LvlOff[ i+1 ]; k+=m)
+      {
+         m = MIN(LvlOff[ i+1 ] - k, par->NmbCpu * WrkPerGrp);
+
+         if(!(grp = NewGrp(par)))
+            return(0);
+
+         grp->idx = ++NmbGrp;
+
+         if(LstGrp)
+            LstGrp->nex = grp;
+         else
+            typ->NexGrp = grp;
+
+         LstGrp = grp;
+
+         for(t=0;t<par->NmbCpu;t++)
+            for(j = t * m / par->NmbCpu; j < (t+1) * m / par->NmbCpu; j++)
+               grp->SmlWrkTab[t][ grp->NmbSmlWrk[t]++ ] = &typ->SmlWrkTab[ OrdTab[ k+j ] ];
+      }
+
+   typ->NmbGrp = NmbGrp;
+
+   LPL_free(par->lmb, LvlTab);
+   LPL_free(par->lmb, LvlOff);
+   LPL_free(par->lmb, OrdTab);
+
+   return(SetGrpWai(par, typ));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free a type's precedence graph                                             */
+/*----------------------------------------------------------------------------*/
+
+static void FreOrd(ParSct *par, TypSct *typ)
+{
+   if(typ->OrdPre)
+      LPL_free(par->lmb, typ->OrdPre);
+
+   if(typ->OrdCnt)
+      LPL_free(par->lmb, typ->OrdCnt);
+
+   if(typ->OrdQue)
+      LPL_free(par->lmb, typ->OrdQue);
+
+   if(typ->OrdSucOff)
+      LPL_free(par->lmb, typ->OrdSucOff);
+
+   if(typ->OrdSucTab)
+      LPL_free(par->lmb, typ->OrdSucTab);
+
+   typ->OrdPre = typ->OrdCnt = typ->OrdQue = NULL;
+   typ->OrdSucOff = typ->OrdSucTab = NULL;
+   typ->OrdSiz = 0;
+   typ->OrdUpd = 1;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Get the next WP to be computed                                             */
+/*----------------------------------------------------------------------------*/
+
+static WrkSct *NexGrn(ParSct *par, int PthIdx)
+{
+   int    GrnIdx;
+   PthSct *pth = &par->PthTab[ PthIdx ];
+   WrkSct *wrk;
+
+   // Remove previous work's tags
+   if(pth->wrk)
+   {
+      GrnIdx = GetGrnIdx(par, pth->wrk);
+      ClrBit(par->RunDepTab, GrnIdx);
+      par->ColCpt[ par->GrnCol[ GrnIdx ] ]--;
+
+      if(!par->ColCpt[ par->GrnCol[ GrnIdx ] ])
+         par->CurCol++;
+   }
+
+   wrk = par->NexWrk;
+
+   while(wrk && (par->GrnCol[ GrnIdx = GetGrnIdx(par, wrk) ] <= par->CurCol + 1) )
+   {
+      // Check for dependencies
+      if((GrnIdx <= par->ColTab[ par->CurCol ][1])
+      || ( par->DynSch && (par->CurCol < par->NmbCol)
+         && (GrnIdx <= par->ColTab[ par->CurCol+1 ][1])
+         && !AndWrd(par->NmbDepWrd, wrk->DepWrdTab, par->RunDepTab) ) )
+      {
+         // Unlink wp
+         if(wrk->pre)
+            wrk->pre->nex = wrk->nex;
+         else
+            par->NexWrk = wrk->nex;
+
+         if(wrk->nex)
+            wrk->nex->pre = wrk->pre;
+
+         // Add new work's tags
+         SetBit(par->RunDepTab, GrnIdx);
+
+         return(wrk);
+      }
+
+      wrk = wrk->nex;
+   }
+
+   return(NULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Grain WP are stored in the grains' order, starting from grain one          */
+/*----------------------------------------------------------------------------*/
+
+static int GetGrnIdx(ParSct *par, WrkSct *wrk)
+{
+   return((int)(wrk - par->GrnWrkTab) + 1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate a new kind of elements and set work-packages                      */
+/*----------------------------------------------------------------------------*/
+
+int NewType(int64_t ParIdx, itg NmbLin)
+{
+   int      TypIdx = 0;
+   itg      i, idx, BigWrkSiz, NmbBigWrk;
+   TypSct   *typ;
+   ParSct   *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0);
+
+   if(NmbLin <= 0)
+      return(0);
+
+   // Search for a free type structure
+   for(i=1;i<=MaxTyp;i++)
+      if(!par->TypTab[i].NmbLin)
+      {
+         TypIdx = i;
+         break;
+      }
+
+   if(!TypIdx)
+      return(0);
+
+   typ = &par->TypTab[ TypIdx ];
+   typ->NmbLin = NmbLin;
+   typ->NexGrp = NULL;
+   par->MemPek.TypPek[ TypIdx ] = 0;
+
+   // Compute the size of small work-packages and set them
+   if(!SetSmlWrk(par, typ, 0))
+      return(0);
+
+   // Compute the size of big work-packages
+   if(!(typ->BigWrkTab = NewItlWrk(par, par->NmbCpu * par->SizMul)))
+      return(0);
+
+   // Compute the size of big work-packages
+	if(NmbLin >= par->NmbCpu)
+	{
+		BigWrkSiz = NmbLin / par->NmbCpu;
+		NmbBigWrk = par->NmbCpu;
+	}
+	else
+	{
+		BigWrkSiz = NmbLin;
+		NmbBigWrk = 1;
+	}
+
+	// Set big work-packages
+	idx = 0;
+
+	for(i=0;i<NmbBigWrk;i++)
+	{
+		typ->BigWrkTab[i].ItlTab[0][0] = idx + 1;
+		typ->BigWrkTab[i].ItlTab[0][1] = idx + BigWrkSiz;
+		idx += BigWrkSiz;
+	}
+
+	typ->BigWrkTab[ NmbBigWrk - 1 ].ItlTab[0][1] = NmbLin;
+   UpdMem(par, TypIdx);
+
+   return(TypIdx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Compute the size of small work-packages, allocate and set them             */
+/*----------------------------------------------------------------------------*/
+
+static int SetSmlWrk(ParSct *par, TypSct *typ, int lvl)
+{
+   itg i, idx, NmbLin = typ->NmbLin;
+
+   if(typ->EntSiz && par->L2Siz)
+   {
+      // When the bytes touched per entity are known, a small WP fits in half
+      // the L2 cache, the other half being left to the data it depends on,
+      // while keeping enough WP to feed every thread
+      typ->SmlWrkSiz = (itg)MAX(1, (par->L2Siz / 2) / typ->EntSiz);
+      typ->SmlWrkSiz = MIN(typ->SmlWrkSiz, MAX(1, NmbLin / (MinSmlBlk * par->NmbCpu)));
+   }
+   else if(NmbLin >= par->NmbSmlBlk * par->NmbCpu)
+      typ->SmlWrkSiz = NmbLin / (par->NmbSmlBlk * par->NmbCpu);
+   else
+      typ->SmlWrkSiz = NmbLin;
+
+   // The leaves of an adaptive tree are lvl times halved blocks
+   typ->SmlWrkSiz = MAX(1, typ->SmlWrkSiz >> lvl);
+   typ->NmbSmlWrk = NmbLin / typ->SmlWrkSiz;
+
+   if(NmbLin != typ->NmbSmlWrk * typ->SmlWrkSiz)
+      typ->NmbSmlWrk++;
+
+   // Costs that do not cover lines added since are dropped
+   if(typ->CstSum && (typ->CstLin != NmbLin))
+   {
+      LPL_free(par->lmb, typ->CstSum);
+      typ->CstSum = NULL;
+      typ->CstLin = 0;
+   }
+
+   // Weighted WP share the same cost, which cannot be lower than
+   // the most expensive line so that no WP is left empty
+   typ->CstShf = 0;
+
+   if(typ->CstSum)
+   {
+      typ->SmlCst = MAX(typ->CstSum[ NmbLin ] / typ->NmbSmlWrk, typ->MaxCst);
+      typ->NmbSmlWrk = GetSmlIdx(typ, NmbLin) + 1;
+      typ->SmlWrkSiz = (int)MAX(1, NmbLin / typ->NmbSmlWrk);
+   }
+
+   if(typ->SmlWrkTab)
+      LPL_free(par->lmb, typ->SmlWrkTab);
+
+   if(!(typ->SmlWrkTab = LPL_calloc(par->lmb, typ->NmbSmlWrk * par->SizMul , sizeof(WrkSct))))
+      return(0);
+
+   typ->MaxSmlWrk = typ->NmbSmlWrk * par->SizMul;
+   UpdMem(par, (int)(typ - par->TypTab));
+
+   // Set small work-packages
+   idx = 0;
+
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      if(typ->CstSum)
+      {
+         typ->SmlWrkTab[i].BegIdx = idx + 1;
+         idx = CstIdx(typ, (double)(i + 1), typ->SmlCst, 0.) - 1;
+         typ->SmlWrkTab[i].EndIdx = idx;
+         continue;
+      }
+
+      typ->SmlWrkTab[i].BegIdx = idx + 1;
+      typ->SmlWrkTab[i].EndIdx = idx + typ->SmlWrkSiz;
+      idx += typ->SmlWrkSiz;
+   }
+
+   typ->SmlWrkTab[ typ->NmbSmlWrk - 1 ].EndIdx = NmbLin;
+
+   return(typ->NmbSmlWrk);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Declare the bytes touched per entity to size blocks after the caches       */
+/*----------------------------------------------------------------------------*/
+
+int SetEntitySize(int64_t ParIdx, int TypIdx, size_t EntSiz)
+{
+   TypSct *typ;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance and type
+   if(!ParIdx || (TypIdx < 1) || (TypIdx > MaxTyp))
+      return(0);
+
+   typ = &par->TypTab[ TypIdx ];
+
+   // Small WP cannot be cut again once dependencies have been set
+   if(!typ->NmbLin || typ->DepWrdMat || par->typ1)
+      return(0);
+
+   typ->EntSiz = EntSiz;
+
+   return(SetSmlWrk(par, typ, 0));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Give each entity of a type a cost, from a table or a procedure, so that    */
+/* big and small WP carry the same amount of work instead of entities         */
+/*----------------------------------------------------------------------------*/
+
+int SetEntityCost32(int64_t ParIdx, int TypIdx, float *CstTab,
+                    float (*CstPrc)(int32_t, void *), void *CstArg)
+{
+   return(SetCst((ParSct *)ParIdx, LplInt, TypIdx, CstTab, (void *)CstPrc, CstArg));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Same as above with a cost procedure taking 64 bit indices                  */
+/*----------------------------------------------------------------------------*/
+
+int SetEntityCost64(int64_t ParIdx, int TypIdx, float *CstTab,
+                    float (*CstPrc)(int64_t, void *), void *CstArg)
+{
+   return(SetCst((ParSct *)ParIdx, LplLng, TypIdx, CstTab, (void *)CstPrc, CstArg));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set the costs with a procedure taking indices of the given width           */
+/*----------------------------------------------------------------------------*/
+
+static int SetCst( ParSct *par, int wid, int TypIdx, float *CstTab,
+                   void *CstPrc, void *CstArg )
+{
+   int      i;
+   double   off = 0.;
+   TypSct   *typ;
+   CstSct   cst;
+
+   // Get and check lib parallel instance and type
+   if(!par || (TypIdx < 1) || (TypIdx > MaxTyp) || par->typ1)
+      return(0);
+
+   typ = &par->TypTab[ TypIdx ];
+
+   if(!typ->NmbLin || ((wid == LplInt) && (typ->NmbLin > INT32_MAX)))
+      return(0);
+
+   if(typ->CstSum)
+   {
+      LPL_free(par->lmb, typ->CstSum);
+      typ->CstSum = NULL;
+      typ->CstLin = 0;
+   }
+
+   // Compute the cost prefix sum in two passes: each thread sums its own
+   // block, then adds the sum of the preceding blocks
+   if(CstTab || CstPrc)
+   {
+      if(!(cst.sum = LPL_malloc(par->lmb, (typ->NmbLin + 1) * sizeof(double))))
+         return(0);
+
+      cst.tab = CstTab;
+      cst.prc = (float (*)(itg, void *))CstPrc;
+      cst.PrcWid = wid;
+      cst.arg = CstArg;
+      cst.sum[0] = cst.MaxCst = 0.;
+      cst.off = par->PthCst;
+      cst.max = &par->PthCst[ par->NmbCpu ];
+      par->prc = CstSumPss;
+      par->arg = &cst;
+
+      for(i=0;i<par->NmbCpu;i++)
+         cst.off[i] = cst.max[i] = 0.;
+
+      TemLch(par, typ, 1, typ->NmbLin, par->NmbCpu, 1);
+
+      for(i=0;i<par->NmbCpu;i++)
+      {
+         cst.MaxCst = MAX(cst.MaxCst, cst.max[i]);
+         off += cst.off[i];
+         cst.off[i] = off - cst.off[i];
+      }
+
+      par->prc = CstOffPss;
+      TemLch(par, typ, 1, typ->NmbLin, par->NmbCpu, 1);
+
+      // Types without any cost keep the even cutting
+      if(cst.sum[ typ->NmbLin ] > 0.)
+      {
+         typ->CstSum = cst.sum;
+         typ->CstLin = typ->NmbLin;
+         typ->MaxCst = cst.MaxCst;
+      }
+      else
+         LPL_free(par->lmb, cst.sum);
+   }
+
+   // Cut the plain big WP again, interleaved ones are set at launch time
+   SetBigWrk(par, typ);
+
+   // Small WP cannot be cut again once dependencies have been set
+   if(typ->DepWrdMat)
+      return(1);
+
+   return(SetSmlWrk(par, typ, 0) ? 1 : 0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set the user's priority of each entity of a type, a dependency WP getting  */
+/* the highest priority of its lines, or remove them with a NULL table        */
+/*----------------------------------------------------------------------------*/
+
+int SetEntityPriority(int64_t ParIdx, int TypIdx, float *PriTab)
+{
+   TypSct   *typ;
+   ParSct   *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance and type
+   if(!ParIdx || (TypIdx < 1) || (TypIdx > MaxTyp) || par->typ1)
+      return(0);
+
+   typ = &par->TypTab[ TypIdx ];
+
+   if(!typ->NmbLin)
+      return(0);
+
+   if(typ->PriTab)
+   {
+      LPL_free(par->lmb, typ->PriTab);
+      typ->PriTab = NULL;
+   }
+
+   if(PriTab)
+   {
+      if(!(typ->PriTab = LPL_malloc(par->lmb, (typ->NmbLin + 1) * sizeof(float))))
+         return(0);
+
+      memcpy(typ->PriTab, PriTab, (typ->NmbLin + 1) * sizeof(float));
+      UpdMem(par, TypIdx);
+   }
+
+   // Sort the WP again according to their new priorities
+   if(typ->SrtFlg)
+      SrtSmlWrk(typ, 1);
+   else
+      ChgWrk(typ);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* First pass of the cost prefix sum: local sums and maximum cost             */
+/*----------------------------------------------------------------------------*/
+
+static void CstSumPss(itg BegIdx, itg EndIdx, int PthIdx, void *arg)
+{
+   itg      i;
+   float    val;
+   double   sum = 0., max = 0.;
+   CstSct   *cst = (CstSct *)arg;
+
+   for(i=BegIdx; i<=EndIdx; i++)
+   {
+      if(cst->tab)
+         val = cst->tab[i];
+      else if(cst->PrcWid == LplInt)
+         val = ((float (*)(int32_t, void *))(void (*)(void))cst->prc)((int32_t)i, cst->arg);
+      else
+         val = cst->prc(i, cst->arg);
+
+      val = MAX(val, 0.f);
+      sum += val;
+      max = MAX(max, val);
+      cst->sum[i] = sum;
+   }
+
+   cst->off[ PthIdx ] = sum;
+   cst->max[ PthIdx ] = max;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Second pass of the cost prefix sum: add the preceding blocks' sum          */
+/*----------------------------------------------------------------------------*/
+
+static void CstOffPss(itg BegIdx, itg EndIdx, int PthIdx, void *arg)
+{
+   itg      i;
+   CstSct   *cst = (CstSct *)arg;
+
+   if(!cst->off[ PthIdx ])
+      return;
+
+   for(i=BegIdx; i<=EndIdx; i++)
+      cst->sum[i] += cst->off[ PthIdx ];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Return the first line whose preceding cost, counted from org and           */
+/* divided by siz, reaches val: it is where block number val begins          */
+/*----------------------------------------------------------------------------*/
+
+static itg CstIdx(TypSct *typ, double val, double siz, double org)
+{
+   itg beg = 1, end = typ->CstLin + 1, mid;
+
+   while(beg < end)
+   {
+      mid = beg + (end - beg) / 2;
+
+      if((typ->CstSum[ mid - 1 ] - org) / siz >= val)
+         end = mid;
+      else
+         beg = mid + 1;
+   }
+
+   return(beg);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Return the small WP, in index order, that holds a given line, weighted WP  */
+/* being made of the lines whose preceding cost falls in the same slice       */
+/*----------------------------------------------------------------------------*/
+
+static int GetSmlIdx(TypSct *typ, itg idx)
+{
+   if(!typ->CstSum)
+      return((int)((idx - 1) / typ->SmlWrkSiz));
+
+   if(idx <= typ->CstLin)
+      return((int)(typ->CstSum[ idx - 1 ] / typ->SmlCst) >> typ->CstShf);
+
+   // Lines added by ResizeType are cut evenly after the weighted ones
+   return(((int)(typ->CstSum[ typ->CstLin - 1 ] / typ->SmlCst) >> typ->CstShf)
+         + 1 + (int)((idx - typ->CstLin - 1) / typ->SmlWrkSiz));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Get the data caches' sizes and the number of cpus sharing the last one     */
+/*----------------------------------------------------------------------------*/
+
+static void GetCacSiz(ParSct *par)
+{
+#if defined(__linux__)
+   int      i, lvl, beg, end, NmbPth;
+   char     nam[256], typ[32], unt, *ptr, lst[1024];
+   size_t   siz;
+   FILE     *hdl;
+
+   for(i=0;i<MaxCacIdx;i++)
+   {
+      // Read the cache level and kind and skip instruction caches
+      sprintf(nam, "/sys/devices/system/cpu/cpu0/cache/index%d/level", i);
+
+      if(!(hdl = fopen(nam, "r")))
+         break;
+
+      if(fscanf(hdl, "%d", &lvl) != 1)
+         lvl = 0;
+
+      fclose(hdl);
+
+      sprintf(nam, "/sys/devices/system/cpu/cpu0/cache/index%d/type", i);
+
+      if(!(hdl = fopen(nam, "r")))
+         continue;
+
+      if(fscanf(hdl, "%31s", typ) != 1)
+         typ[0] = 0;
+
+      fclose(hdl);
+
+      if(!strcmp(typ, "Instruction"))
+         continue;
+
+      // Sizes are given in KB or MB
+      sprintf(nam, "/sys/devices/system/cpu/cpu0/cache/index%d/size", i);
+
+      if(!(hdl = fopen(nam, "r")))
+         continue;
+
+      unt = 0;
+
+      if(fscanf(hdl, "%zu%c", &siz, &unt) < 1)
+         siz = 0;
+
+      fclose(hdl);
+
+      if(unt == 'K')
+         siz *= 1024;
+      else if(unt == 'M')
+         siz *= 1024 * 1024;
+
+      // Count the cpus sharing this cache from a list like "0-15,32-47"
+      NmbPth = 1;
+      sprintf(nam, "/sys/devices/system/cpu/cpu0/cache/index%d/shared_cpu_list", i);
+
+      if((hdl = fopen(nam, "r")))
+      {
+         if(fscanf(hdl, "%1023s", lst) == 1)
+         {
+            NmbPth = 0;
+
+            for(ptr = strtok(lst, ","); ptr; ptr = strtok(NULL, ","))
+               if(sscanf(ptr, "%d-%d", &beg, &end) == 2)
+                  NmbPth += end - beg + 1;
+               else
+                  NmbPth++;
+         }
+
+         fclose(hdl);
+      }
+
+      if(lvl == 1)
+         par->L1Siz = siz;
+      else if(lvl == 2)
+         par->L2Siz = siz;
+
+      if(lvl >= 2)
+      {
+         par->LlcSiz = siz;
+         par->LlcPth = MAX(1, NmbPth);
+      }
+   }
+#elif defined(__MACH__)
+   int64_t  siz;
+   size_t   len = sizeof(siz);
+
+   if(!sysctlbyname("hw.l1dcachesize", &siz, &len, NULL, 0))
+      par->L1Siz = (size_t)siz;
+
+   len = sizeof(siz);
+
+   if(!sysctlbyname("hw.l2cachesize", &siz, &len, NULL, 0))
+      par->L2Siz = par->LlcSiz = (size_t)siz;
+
+   len = sizeof(siz);
+
+   if(!sysctlbyname("hw.l3cachesize", &siz, &len, NULL, 0) && siz)
+      par->LlcSiz = (size_t)siz;
+
+   par->LlcPth = 1;
+#else
+   (void)(par);
+#endif
+
+   // Without a shared cache level, the L2 is treated as the last level
+   if(!par->LlcSiz)
+   {
+      par->LlcSiz = par->L2Siz;
+      par->LlcPth = 1;
+   }
+
+   // The thread count of the last level cache cannot exceed the pool's size
+   par->LlcPth = MAX(1, MIN(par->LlcPth, par->NmbCpu));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Return the data caches' sizes detected at init time, 0 if unknown          */
+/*----------------------------------------------------------------------------*/
+
+int GetCacheSizes(int64_t ParIdx, size_t *L1Siz, size_t *L2Siz, size_t *LlcSiz)
+{
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx || !L1Siz || !L2Siz || !LlcSiz)
+      return(0);
+
+   *L1Siz = par->L1Siz;
+   *L2Siz = par->L2Siz;
+   *LlcSiz = par->LlcSiz;
+
+   return(par->L2Siz ? 1 : 0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Adaptive big block resizing based on run time                              */
+/*----------------------------------------------------------------------------*/
+
+static void UpdBlkSiz(ParSct *par, TypSct *typ)
+{
+   int      i, CurBlk = 0;
+   itg      CurLin = 0, (*NewBlk)[2] = par->PthBlk;
+   double   sca, AvgTim, RemTim, TotTim = 0.;
+
+   for(i=0;i<par->NmbCpu;i++)
+      TotTim += typ->BigWrkTab[i].RunTim;
+
+   AvgTim = TotTim / par->NmbCpu;
+
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      NewBlk[i][0] = CurLin + 1;
+      TotTim = 0;
+
+      do
+      {
+         RemTim = (typ->BigWrkTab[ CurBlk ].RunTim
+                * (typ->BigWrkTab[ CurBlk ].ItlTab[0][1] - CurLin))
+                / (typ->BigWrkTab[ CurBlk ].ItlTab[0][1]
+                - typ->BigWrkTab[ CurBlk ].ItlTab[0][0]);
+
+         if(TotTim + RemTim < AvgTim)
+         {
+            CurLin = typ->BigWrkTab[ CurBlk ].ItlTab[0][1];
+            TotTim += RemTim;
+            CurBlk++;
+         }
+         else
+         {
+            sca = (AvgTim - TotTim) / typ->BigWrkTab[ CurBlk ].RunTim;
+            CurLin += sca * (typ->BigWrkTab[ CurBlk ].ItlTab[0][1]
+                           - typ->BigWrkTab[ CurBlk ].ItlTab[0][0]);
+            break;
+         }
+      }while(TotTim < AvgTim);
+
+      NewBlk[i][1] = CurLin;
+   }
+
+   NewBlk[ par->NmbCpu - 1 ][1] = typ->NmbLin;
+
+	for(i=0;i<par->NmbCpu;i++)
+   {
+      typ->BigWrkTab[i].ItlTab[0][0] = NewBlk[i][0];
+      typ->BigWrkTab[i].ItlTab[0][1] = NewBlk[i][1];
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Grow or shrink a data type, the small WP and their dependencies are kept   */
+/* for the lines left and new WP without dependencies are appended            */
+/*----------------------------------------------------------------------------*/
+
+int ResizeType(int64_t ParIdx, int TypIdx, itg NmbLin)
+{
+   itg      i;
+   TypSct   *typ;
+   ParSct   *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0);
+
+   // Check bounds and free mem
+   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
+      return(0);
+
+   typ = &par->TypTab[ TypIdx ];
+
+   if(!typ->NmbLin || (NmbLin < 1) || par->typ1)
+      return(0);
+
+   // New blocks are appended to the leaves, so the adaptive tree is dropped
+   if(typ->NodTab)
+      RstLef(par, typ);
+
+   // and so are the schedules derived from the blocks
+   ChgWrk(typ);
+   DrpSnp(par, typ);
+
+   // User priorities do not cover the new lines
+   if(typ->PriTab)
+   {
+      LPL_free(par->lmb, typ->PriTab);
+      typ->PriTab = NULL;
+   }
+
+   if(!RszSml(par, typ, NmbLin))
+      return(0);
+
+   typ->NmbLin = NmbLin;
+
+#if ( __STDC_VERSION__ > 201100L )
+   // Locks are all released between two launches, new ones can be cleared
+   if(typ->AtoLok && (NmbLin > typ->NmbLok))
+   {
+      LPL_free(par->lmb, typ->AtoLok);
+
+      if(!(typ->AtoLok = LPL_calloc(par->lmb, NmbLin + 1, sizeof(int))))
+         return(0);
+
+      typ->NmbLok = NmbLin;
+   }
+#endif
+
+   // Widen the dependency words of the types depending on this one
+   for(i=1;i<=MaxTyp;i++)
+      if( (i != TypIdx) && par->TypTab[i].DepWrdMat && !RszDep(par, &par->TypTab[i]) )
+         return(0);
+
+   // Cut the big WP again, from the costs if they still cover all lines:
+   // lines added since have none and make a grown type's big WP even
+   SetBigWrk(par, typ);
+   UpdMem(par, TypIdx);
+
+   return(TypIdx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Cut the small WP at a new number of lines: the last WP kept is truncated   */
+/* or completed and new evenly sized ones are appended, the tables growing    */
+/* SizMul times larger than needed so that successive resizes are amortized   */
+/*----------------------------------------------------------------------------*/
+
+static int RszSml(ParSct *par, TypSct *typ, itg NmbLin)
+{
+   int      i, r = 0, NmbSml = 0, NewSml, *UseRow, *NewMat;
+   itg      idx;
+   WrkSct   *wrk, *NewTab;
+
+   // Work on the WP in index order
+   if(typ->SrtFlg)
+      qsort(typ->SmlWrkTab, typ->NmbSmlWrk, sizeof(WrkSct), CmpBeg);
+
+   while( (NmbSml < typ->NmbSmlWrk) && (typ->SmlWrkTab[ NmbSml ].BegIdx <= NmbLin) )
+      NmbSml++;
+
+   // A WP cut evenly is completed to its full size so that GetSmlIdx()
+   // still finds it, a weighted one ends where the weighted lines end
+   wrk = &typ->SmlWrkTab[ NmbSml - 1 ];
+
+   if(!typ->CstSum || (wrk->BegIdx > typ->CstLin))
+      wrk->EndIdx = MIN(NmbLin, wrk->BegIdx + typ->SmlWrkSiz - 1);
+   else
+      wrk->EndIdx = MIN(NmbLin, wrk->EndIdx);
+
+   typ->CstLin = MIN(typ->CstLin, NmbLin);
+   idx = wrk->EndIdx;
+   NewSml = NmbSml + (int)((NmbLin - idx + typ->SmlWrkSiz - 1) / typ->SmlWrkSiz);
+
+   if(NewSml > typ->MaxSmlWrk)
+   {
+      if(!(NewTab = LPL_calloc(par->lmb, NewSml * par->SizMul, sizeof(WrkSct))))
+         return(0);
+
+      memcpy(NewTab, typ->SmlWrkTab, NmbSml * sizeof(WrkSct));
+      LPL_free(par->lmb, typ->SmlWrkTab);
+      typ->SmlWrkTab = NewTab;
+      typ->MaxSmlWrk = NewSml * par->SizMul;
+      typ->NmbAff = 0;
+   }
+
+   for(i=NmbSml;i<NewSml;i++)
+   {
+      wrk = &typ->SmlWrkTab[i];
+      memset(wrk, 0, sizeof(WrkSct));
+      wrk->BegIdx = idx + 1;
+      wrk->EndIdx = MIN(NmbLin, idx + typ->SmlWrkSiz);
+      idx = wrk->EndIdx;
+   }
+
+   // The dependency rows of the WP kept are packed in a larger matrix,
+   // or the new WP take the rows no WP uses anymore
+   if(typ->DepWrdMat && (NewSml > typ->MaxDepRow))
+   {
+      if(!(NewMat = AlcHug(par->lmb, (int64_t)NewSml * par->SizMul * typ->DepWrdStr
+                           * sizeof(int), LplHugePages | LplClearMemory)))
+      {
+         return(0);
+      }
+
+      for(i=0;i<NewSml;i++)
+      {
+         wrk = &typ->SmlWrkTab[i];
+
+         if(i < NmbSml)
+            memcpy(&NewMat[ i * typ->DepWrdStr ], wrk->DepWrdTab,
+                   typ->DepWrdStr * sizeof(int));
+
+         wrk->DepWrdTab = &NewMat[ i * typ->DepWrdStr ];
+      }
+
+      FreHug(par->lmb, typ->DepWrdMat);
+      typ->DepWrdMat = NewMat;
+      typ->MaxDepRow = NewSml * par->SizMul;
+   }
+   else if(typ->DepWrdMat && (NewSml > NmbSml))
+   {
+      if(!(UseRow = LPL_calloc(par->lmb, typ->MaxDepRow, sizeof(int))))
+         return(0);
+
+      for(i=0;i<NmbSml;i++)
+         UseRow[ (typ->SmlWrkTab[i].DepWrdTab - typ->DepWrdMat) / typ->DepWrdStr ] = 1;
+
+      for(i=NmbSml;i<NewSml;i++)
+      {
+         while(UseRow[r])
+            r++;
+
+         wrk = &typ->SmlWrkTab[i];
+         wrk->DepWrdTab = &typ->DepWrdMat[ r++ * typ->DepWrdStr ];
+         memset(wrk->DepWrdTab, 0, typ->DepWrdStr * sizeof(int));
+      }
+
+      LPL_free(par->lmb, UseRow);
+   }
+
+   typ->NmbSmlWrk = NewSml;
+
+   if(typ->SrtFlg)
+   {
+      SetPri(typ);
+      qsort(typ->SmlWrkTab, typ->NmbSmlWrk, sizeof(WrkSct), CmpWrk);
+      typ->SrtUpd = 0;
+   }
+
+   // Static groups are made again, ordered ones are rebuilt at launch time
+   if(typ->NexGrp && !typ->OrdDep && !SetGrp(par, typ))
+      return(0);
+
+   return(NewSml);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Give each dependency type of a type enough words to cover its lines, the   */
+/* ranges are moved within the rows when they fit or to a matrix with rows    */
+/* SizMul times wider than needed                                             */
+/*----------------------------------------------------------------------------*/
+
+static int RszDep(ParSct *par, TypSct *typ)
+{
+   int      i, k, NmbRng = MAX(1, typ->NmbDepTyp), NmbWrd = 0, BlkSiz, str;
+   int      OldOff[ MaxDepTyp ], OldWrd[ MaxDepTyp ], NewOff[ MaxDepTyp ];
+   int      NewWrd[ MaxDepTyp ], *NewMat, *OldRow, *NewRow;
+   itg      NmbLin;
+
+   for(k=0;k<NmbRng;k++)
+   {
+      NmbLin = par->TypTab[ typ->DepTypIdx[k] ].NmbLin;
+      BlkSiz = k ? typ->DepBlkSiz[k] : typ->DepWrkSiz;
+      OldOff[k] = (NmbRng > 1) ? typ->DepBitOff[k] / 32 : 0;
+      OldWrd[k] = (NmbRng > 1) ? (typ->DepBitLst[k] + 1) / 32 - OldOff[k] : typ->NmbDepWrd;
+      NewWrd[k] = MAX(OldWrd[k], (int)((NmbLin + (itg)BlkSiz * 32 - 1) / ((itg)BlkSiz * 32)));
+      NewOff[k] = NmbWrd;
+      NmbWrd += NewWrd[k];
+   }
+
+   if(NmbWrd == typ->NmbDepWrd)
+      return(1);
+
+   if(typ->NodTab)
+      RstLef(par, typ);
+
+   ChgWrk(typ);
+   DrpSnp(par, typ);
+
+   // Wider rows need a new matrix and new tables of running tags and priorities
+   if(NmbWrd > typ->DepWrdStr)
+   {
+      str = NmbWrd * par->SizMul;
+
+      if(!(NewMat = AlcHug(par->lmb, (int64_t)typ->MaxDepRow * str * sizeof(int),
+                           LplHugePages | LplClearMemory)))
+      {
+         return(0);
+      }
+
+      LPL_free(par->lmb, typ->RunDepTab);
+
+      if(!(typ->RunDepTab = LPL_calloc(par->lmb, str, sizeof(int))))
+         return(0);
+
+      if(typ->PriBit)
+      {
+         LPL_free(par->lmb, typ->PriBit);
+
+         if(!(typ->PriBit = LPL_malloc(par->lmb, str * 32 * sizeof(float))))
+            return(0);
+      }
+   }
+   else
+   {
+      str = typ->DepWrdStr;
+      NewMat = typ->DepWrdMat;
+   }
+
+   // Ranges only move to the right, so they are moved from the last one
+   // and each one's new words are cleared once the next ones are in place
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      OldRow = typ->SmlWrkTab[i].DepWrdTab;
+      NewRow = &NewMat[ (OldRow - typ->DepWrdMat) / typ->DepWrdStr * str ];
+
+      for(k=NmbRng-1;k>=0;k--)
+      {
+         memmove(&NewRow[ NewOff[k] ], &OldRow[ OldOff[k] ], OldWrd[k] * sizeof(int));
+         memset(&NewRow[ NewOff[k] + OldWrd[k] ], 0, (NewWrd[k] - OldWrd[k]) * sizeof(int));
+      }
+
+      typ->SmlWrkTab[i].DepWrdTab = NewRow;
+   }
+
+   if(NewMat != typ->DepWrdMat)
+   {
+      FreHug(par->lmb, typ->DepWrdMat);
+      typ->DepWrdMat = NewMat;
+      typ->DepWrdStr = str;
+   }
+
+   typ->NmbDepWrd = NmbWrd;
+
+   for(k=0;k<NmbRng;k++)
+   {
+      typ->DepBitOff[k] = NewOff[k] * 32;
+      typ->DepBitLst[k] = (NewOff[k] + NewWrd[k]) * 32 - 1;
+   }
+
+   if(typ->NexGrp && !typ->OrdDep && !SetGrp(par, typ))
+      return(0);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Drop the tuners' snapshots of a type's blocks, which a resize invalidates  */
+/*----------------------------------------------------------------------------*/
+
+static void DrpSnp(ParSct *par, TypSct *typ)
+{
+   int i;
+
+   for(i=0;i<par->NmbTun;i++)
+      if(&par->TypTab[ par->TunTab[i].TypIdx1 ] == typ)
+         FreSnp(par, &par->TunTab[i]);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set big work blocks interleaving                                           */
+/*----------------------------------------------------------------------------*/
+
+static void SetItlBlk(ParSct *par, TypSct *typ)
+{
+   int      CstFlg = typ->CstSum && (typ->CstLin == typ->NmbLin);
+   itg      i, j, BegIdx, EndIdx, CpuIdx = 0;
+   int      *PagIdx = par->PthPag;
+   double   ItlSiz = 0., ItlIdx = 0., ItlCst;
+
+   // Set big WP interleaved indices and block sizes if requested
+   if(par->NmbItlBlk)
+      ItlSiz = (double)typ->NmbLin / (double)(par->NmbItlBlk * par->NmbCpu);
+   else if(par->ItlBlkSiz)
+   {
+      par->NmbItlBlk = typ->NmbLin / (par->ItlBlkSiz * par->NmbCpu);
+      ItlSiz = (double)par->ItlBlkSiz;
+
+      // Too small blocks are enlarged to fit in the WP's table of ranges
+      if(par->NmbItlBlk > MaxItlBlk)
+      {
+         par->NmbItlBlk = MaxItlBlk;
+         ItlSiz = (double)typ->NmbLin / (double)(MaxItlBlk * par->NmbCpu);
+      }
+   }
+
+   memset(PagIdx, 0, par->NmbCpu * sizeof(int));
+
+   // In case the block or lines numbers is too small, deactivate interleaving
+   if(!par->NmbItlBlk || !ItlSiz)
+   {
+      par->NmbItlBlk = 1;
+      ItlSiz = (double)typ->NmbLin / (double)(par->NmbCpu);
+   }
+
+   // Blocks without any line are skipped, so the ones left
+   // from a former cut of more lines must be cleared
+   for(i=0;i<par->NmbCpu;i++)
+      memset(typ->BigWrkTab[i].ItlTab, 0, par->NmbItlBlk * 2 * sizeof(itg));
+
+   // Weighted blocks share the same cost instead of the same number of lines,
+   // an empty one is still stored so that no former block is left behind
+   ItlCst = CstFlg ? typ->CstSum[ typ->NmbLin ] / (par->NmbItlBlk * par->NmbCpu) : 0.;
+
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      for(j=0;j<par->NmbItlBlk;j++)
+      {
+         if(CstFlg)
+         {
+            BegIdx = CstIdx(typ, (double)(i * par->NmbItlBlk + j), ItlCst, 0.);
+            EndIdx = CstIdx(typ, (double)(i * par->NmbItlBlk + j + 1), ItlCst, 0.) - 1;
+         }
+         else
+         {
+            BegIdx = (itg)(ItlIdx + 1.);
+            EndIdx = (itg)(ItlIdx + ItlSiz);
+            ItlIdx += ItlSiz;
+         }
+
+         if(CstFlg || (BegIdx <= EndIdx))
+         {
+            typ->BigWrkTab[ CpuIdx ].ItlTab[ PagIdx[ CpuIdx ] ][0] = BegIdx;
+            typ->BigWrkTab[ CpuIdx ].ItlTab[ PagIdx[ CpuIdx ] ][1] = EndIdx;
+            PagIdx[ CpuIdx ]++;
+            CpuIdx++;
+            CpuIdx = CpuIdx % par->NmbCpu;
+         }
+      }
+   }
+
+   typ->BigWrkTab[ par->NmbCpu - 1 ].ItlTab[ par->NmbItlBlk - 1 ][1] = typ->NmbLin;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Cut a type's plain big WP, weighted by the entities' costs if any          */
+/*----------------------------------------------------------------------------*/
+
+static void SetBigWrk(ParSct *par, TypSct *typ)
+{
+   int NmbItlBlk = par->NmbItlBlk, ItlBlkSiz = par->ItlBlkSiz;
+
+   par->NmbItlBlk = 1;
+   par->ItlBlkSiz = 0;
+   SetItlBlk(par, typ);
+   par->NmbItlBlk = NmbItlBlk;
+   par->ItlBlkSiz = ItlBlkSiz;
+   typ->NmbItlBlk = 1;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Add this kind of element to the free-list                                  */
+/*----------------------------------------------------------------------------*/
+
+void FreeType(int64_t ParIdx, int TypIdx)
+{
+   int    i;
+   TypSct *typ;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return;
+
+   // Check bounds and free mem
+   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
+      return;
+
+   typ = &par->TypTab[ TypIdx ];
+
+   if(typ->SmlWrkTab)
+      LPL_free(par->lmb, typ->SmlWrkTab);
+
+   if(typ->BigWrkTab)
+      FreItlWrk(par, typ->BigWrkTab);
+
+   if(typ->RunDepTab)
+      LPL_free(par->lmb, typ->RunDepTab);
+
+   if(typ->DepWrdMat)
+      FreHug(par->lmb, typ->DepWrdMat);
+
+   if(typ->NodTab)
+      FreNod(par, typ);
+
+   if(typ->CstSum)
+      LPL_free(par->lmb, typ->CstSum);
+
+   if(typ->AffTab)
+      LPL_free(par->lmb, typ->AffTab);
+
+   if(typ->AffSlt)
+      LPL_free(par->lmb, typ->AffSlt);
+
+   if(typ->PriTab)
+      LPL_free(par->lmb, typ->PriTab);
+
+   if(typ->PriBit)
+      LPL_free(par->lmb, typ->PriBit);
+
+#if ( __STDC_VERSION__ > 201100L )
+   if(typ->AtoLok)
+      LPL_free(par->lmb, typ->AtoLok);
+#endif
+
+   FreGrp(par, typ);
+   FreRpl(par, typ);
+   FreOrd(par, typ);
+
+   // Remove the launch policies attached to this type as its index may be reused
+   for(i=par->NmbPol-1;i>=0;i--)
+      if( (par->PolTab[i].TypIdx == TypIdx) || (par->PolTab[i].TypIdx2 == TypIdx) )
+         par->PolTab[i] = par->PolTab[ --par->NmbPol ];
+
+   // Same thing with the tuned procedures, the ones loaded from a file
+   // and not yet bound to a procedure are kept for a future type
+   for(i=par->NmbTun-1;i>=0;i--)
+      if( par->TunTab[i].prc && ( (par->TunTab[i].TypIdx1 == TypIdx)
+      ||  (par->TunTab[i].TypIdx2 == TypIdx) ) )
+      {
+         FreSnp(par, &par->TunTab[i]);
+         par->TunTab[i] = par->TunTab[ --par->NmbTun ];
+      }
+
+   memset(typ, 0, sizeof(TypSct));
+
+   // Take the type's tables out of the running totals
+   UpdMem(par, TypIdx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Compute the size of a type2's dependency blocks and the number of words    */
+/* storing their bits                                                         */
+/*----------------------------------------------------------------------------*/
+
+static void SetDepSiz(ParSct *par, TypSct *typ2, int *DepWrkSiz, int *NmbDepWrd)
+{
+   if(typ2->EntSiz && par->LlcSiz)
+   {
+      // A dependency block fits in a thread's share of the last level cache
+      // as long as there are enough blocks to limit collisions
+      *DepWrkSiz = (int)MAX(1, par->LlcSiz / (par->LlcPth * typ2->EntSiz));
+      *DepWrkSiz = MIN(*DepWrkSiz, MAX(1, typ2->NmbLin / (MinDepBlk * par->NmbCpu)));
+      *NmbDepWrd = typ2->NmbLin / (*DepWrkSiz * 32);
+
+      if(typ2->NmbLin != *NmbDepWrd * *DepWrkSiz * 32)
+         (*NmbDepWrd)++;
+   }
+   else if( (typ2->NmbLin >= par->NmbDepBlk * par->NmbCpu)
+   &&  (typ2->NmbLin >= *DepWrkSiz * 32) )
+   {
+      *DepWrkSiz = typ2->NmbLin / (par->NmbDepBlk * par->NmbCpu);
+      *NmbDepWrd = typ2->NmbLin / (*DepWrkSiz * 32);
+
+      if(typ2->NmbLin != *NmbDepWrd * *DepWrkSiz * 32)
+         (*NmbDepWrd)++;
+   }
+   else
+   {
+      *DepWrkSiz = typ2->NmbLin;
+      *NmbDepWrd = 1;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Get the rank of a type among type1's dependency types, the first one       */
+/* being the default                                                          */
+/*----------------------------------------------------------------------------*/
+
+static int GetDepTyp(TypSct *typ1, int TypIdx2)
+{
+   int i;
+
+   for(i=0;i<typ1->NmbDepTyp;i++)
+      if(typ1->DepTypIdx[i] == TypIdx2)
+         return(i);
+
+   return(-1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Get the dependency bit of a type2 entity, with several types, entities     */
+/* added by a resize beyond a type's range share the range's last bit         */
+/*----------------------------------------------------------------------------*/
+
+static int GetDepBit(TypSct *typ1, int TypIdx2, itg idx2)
+{
+   int k, bit;
+
+   // A type the loop was not set against has no range of bits
+   if((k = GetDepTyp(typ1, TypIdx2)) < 0)
+      return(-1);
+
+   if(typ1->NmbDepTyp < 2)
+      return((int)((idx2 - 1) / typ1->DepWrkSiz));
+
+   bit = typ1->DepBitOff[k] + (int)((idx2 - 1) / (k ? typ1->DepBlkSiz[k] : typ1->DepWrkSiz));
+
+   return(MIN(bit, typ1->DepBitLst[k]));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Count the number of dependency blocks of all type1's dependency types      */
+/*----------------------------------------------------------------------------*/
+
+static int CntDepBit(ParSct *par, TypSct *typ1)
+{
+   int   i, siz, NmbBit, NmbDepBit = 0;
+   itg   NmbLin;
+
+   for(i=0;i<MAX(1, typ1->NmbDepTyp);i++)
+   {
+      NmbLin = par->TypTab[ typ1->DepTypIdx[i] ].NmbLin;
+      siz = i ? typ1->DepBlkSiz[i] : typ1->DepWrkSiz;
+
+      if(NmbLin >= siz)
+      {
+         NmbBit = (int)(NmbLin / siz);
+
+         if(NmbLin - NmbBit * siz)
+            NmbBit++;
+      }
+      else
+         NmbBit = 1;
+
+      NmbDepBit += NmbBit;
+   }
+
+   return(NmbDepBit);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate a dependency matrix linking both types                            */
+/*----------------------------------------------------------------------------*/
+
+int BeginDependency(int64_t ParIdx, int TypIdx1, int TypIdx2)
+{
+   return(BeginDependencyMultiType(ParIdx, TypIdx1, 1, &TypIdx2));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate a dependency matrix linking type1 to several types, each one      */
+/* owning its own range of dependency words so that a single launch checks    */
+/* the collisions against all of them                                         */
+/*----------------------------------------------------------------------------*/
+
+int BeginDependencyMultiType( int64_t ParIdx, int TypIdx1,
+                              int NmbTyp, int *TypTab )
+{
+   int i, j, DepWrkSiz, NmbDepWrd;
+   TypSct *typ1, *typ2;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx || !TypTab || (NmbTyp < 1) || (NmbTyp > MaxDepTyp))
+      return(0);
+
+   // Check bounds
+   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) )
+      return(0);
+
+   par->CurTyp = typ1 = &par->TypTab[ TypIdx1 ];
+
+   if(!typ1->NmbLin)
+      return(0);
+
+   for(i=0;i<NmbTyp;i++)
+   {
+      if( (TypIdx1 == TypTab[i]) || (TypTab[i] < 1) || (TypTab[i] > MaxTyp)
+      ||  !par->TypTab[ TypTab[i] ].NmbLin )
+      {
+         return(0);
+      }
+
+      for(j=0;j<i;j++)
+         if(TypTab[i] == TypTab[j])
+            return(0);
+   }
+
+   par->DepTyp = typ2 = &par->TypTab[ TypTab[0] ];
+
+   // Release the dependencies of a former BeginDependency
+   FreDep(par, typ1);
+
+   // With the adaptive tree and dynamic scheduling, small WP are cut NmbAdpLvl
+   // times finer to become the leaves of a tree of blocks built by EndDependency
+   if(typ1->NodTab)
+      FreNod(par, typ1);
+
+   ChgWrk(typ1);
+
+   // The tree would alter the blocks' order that ordered dependencies rely on
+   typ1->OrdDep = par->OrdDep;
+   typ1->CrtPth = par->CrtPth;
+   typ1->AdpLvl = (par->AdpTre && par->DynSch && !typ1->OrdDep) ? NmbAdpLvl : 0;
+
+   if(typ1->AdpLvl && !SetSmlWrk(par, typ1, typ1->AdpLvl))
+      return(0);
+
+   // Compute dependency table's size: each type gets its own range of words,
+   // the first type's block size being the one halving may change later
+   typ1->NmbDepTyp = NmbTyp;
+   NmbDepWrd = 0;
+
+   for(i=0;i<NmbTyp;i++)
+   {
+      typ2 = &par->TypTab[ TypTab[i] ];
+      DepWrkSiz = typ1->DepWrkSiz;
+      SetDepSiz(par, typ2, &DepWrkSiz, &j);
+      typ1->DepTypIdx[i] = TypTab[i];
+      typ1->DepBitOff[i] = NmbDepWrd * 32;
+      typ1->DepBlkSiz[i] = DepWrkSiz;
+      typ1->DepBitLst[i] = (NmbDepWrd + j) * 32 - 1;
+      NmbDepWrd += j;
+
+      if(!i)
+         typ1->DepWrkSiz = DepWrkSiz;
+   }
+
+   typ1->NmbDepWrd = NmbDepWrd;
+
+   typ1->SrtFlg = typ1->SrtUpd = typ1->SmlLvl = typ1->DepLvl = typ1->DepFus = 0;
+
+   // Allocate a global dependency table, whose rows leave room
+   // for the growth of the dependency types
+   typ1->MaxDepRow = typ1->NmbSmlWrk;
+   typ1->DepWrdStr = typ1->NmbDepWrd * par->SizMul;
+
+   if(!(typ1->DepWrdMat = AlcHug(par->lmb, (int64_t)typ1->MaxDepRow * typ1->DepWrdStr
+                               * sizeof(int), LplHugePages | LplClearMemory)))
+   {
+      return(0);
+   }
+
+   // Then spread sub-tables among WP
+   for(i=0;i<typ1->NmbSmlWrk;i++)
+   {
+      typ1->SmlWrkTab[i].NmbDep = 0;
+      typ1->SmlWrkTab[i].DepWrdTab = &typ1->DepWrdMat[ i * typ1->DepWrdStr ];
+   }
+
+   // Allocate a running tags table
+   if(!(typ1->RunDepTab = LPL_calloc(par->lmb, typ1->DepWrdStr, sizeof(int))))
+      return(0);
+
+   // and the chain lengths of each dependency block
+   if( typ1->CrtPth && !(typ1->PriBit =
+      LPL_malloc(par->lmb, typ1->DepWrdStr * 32 * sizeof(float))) )
+   {
+      return(0);
+   }
+
+   return(typ1->NmbDepWrd);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free a type's dependency matrix and the schedules derived from it          */
+/*----------------------------------------------------------------------------*/
+
+static void FreDep(ParSct *par, TypSct *typ)
+{
+   int i;
+
+   if(typ->DepWrdMat)
+      FreHug(par->lmb, typ->DepWrdMat);
+
+   if(typ->RunDepTab)
+      LPL_free(par->lmb, typ->RunDepTab);
+
+   if(typ->PriBit)
+      LPL_free(par->lmb, typ->PriBit);
+
+   FreGrp(par, typ);
+   FreRpl(par, typ);
+   FreOrd(par, typ);
+
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      typ->SmlWrkTab[i].NmbDep = 0;
+      typ->SmlWrkTab[i].DepWrdTab = NULL;
+   }
+
+   typ->DepWrdMat = typ->RunDepTab = NULL;
+   typ->PriBit = NULL;
+   typ->NmbDepWrd = typ->NmbDepTyp = typ->MaxDepRow = typ->DepWrdStr = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Type1 element idx1 depends on type2 element idx2                           */
+/*----------------------------------------------------------------------------*/
+
+int AddDependency(int64_t ParIdx, itg idx1, itg idx2)
+{
+   WrkSct *wrk;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if( !par || !par->CurTyp || !par->CurTyp->SmlWrkSiz
+   ||  !par->CurTyp->DepWrkSiz || !par->DepTyp || (idx1 < 1)
+   ||  (idx1 > par->CurTyp->NmbLin) || (idx2 < 1)
+   ||  (idx2 > par->DepTyp->NmbLin) )
+   {
+      return(0);
+   }
+
+   // Set and count dependency bit
+   wrk = &par->CurTyp->SmlWrkTab[ GetSmlIdx(par->CurTyp, idx1) ];
+   par->CurTyp->DepFus = 0;
+
+   if(!SetBit(wrk->DepWrdTab, (idx2-1) / par->CurTyp->DepWrkSiz ))
+      wrk->NmbDep++;
+
+   return(wrk->NmbDep);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Type1 element idx1 depends on element idx2 of one of its dependency types  */
+/*----------------------------------------------------------------------------*/
+
+int AddDependencyMultiType(int64_t ParIdx, int TypIdx2, itg idx1, itg idx2)
+{
+   WrkSct *wrk;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if( !par || !par->CurTyp || !par->CurTyp->SmlWrkSiz
+   ||  !par->CurTyp->DepWrkSiz || (idx1 < 1) || (idx1 > par->CurTyp->NmbLin)
+   ||  (TypIdx2 < 1) || (TypIdx2 > MaxTyp) || (idx2 < 1)
+   ||  (idx2 > par->TypTab[ TypIdx2 ].NmbLin) )
+   {
+      return(0);
+   }
+
+   if(GetDepTyp(par->CurTyp, TypIdx2) < 0)
+      return(0);
+
+   // Set and count dependency bit
+   wrk = &par->CurTyp->SmlWrkTab[ GetSmlIdx(par->CurTyp, idx1) ];
+   par->CurTyp->DepFus = 0;
+
+   if(!SetBit(wrk->DepWrdTab, GetDepBit(par->CurTyp, TypIdx2, idx2)))
+      wrk->NmbDep++;
+
+   return(wrk->NmbDep);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set all to all dependencies without any pre-checking, 32 bit indices       */
+/*----------------------------------------------------------------------------*/
+
+void AddDependencyFast32( int64_t ParIdx, int NmbTyp1, int32_t *TabIdx1,
+                          int NmbTyp2, int32_t *TabIdx2 )
+{
+   AddFst((ParSct *)ParIdx, LplInt, NmbTyp1, TabIdx1, NmbTyp2, TabIdx2);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set all to all dependencies without any pre-checking, 64 bit indices       */
+/*----------------------------------------------------------------------------*/
+
+void AddDependencyFast64( int64_t ParIdx, int NmbTyp1, int64_t *TabIdx1,
+                          int NmbTyp2, int64_t *TabIdx2 )
+{
+   AddFst((ParSct *)ParIdx, LplLng, NmbTyp1, TabIdx1, NmbTyp2, TabIdx2);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set all to all dependencies from tables of indices of the given width      */
+/*----------------------------------------------------------------------------*/
+
+static void AddFst( ParSct *par, int wid, int NmbTyp1, void *TabIdx1,
+                    int NmbTyp2, void *TabIdx2 )
+{
+   int i, j;
+   WrkSct *wrk;
+
+   par->CurTyp->DepFus = 0;
+
+   for(i=0;i<NmbTyp1;i++)
+   {
+      wrk = &par->CurTyp->SmlWrkTab[ GetSmlIdx(par->CurTyp, GetIdx(TabIdx1, wid, i)) ];
+
+      for(j=0;j<NmbTyp2;j++)
+         if( !SetBit(wrk->DepWrdTab, (GetIdx(TabIdx2, wid, j) - 1) / par->CurTyp->DepWrkSiz ) )
+            wrk->NmbDep++;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Read the entry of a user's table of 32 or 64 bit indices                   */
+/*----------------------------------------------------------------------------*/
+
+static itg GetIdx(void *tab, int wid, itg pos)
+{
+   if(wid == LplInt)
+      return(((int32_t *)tab)[ pos ]);
+
+   return(((int64_t *)tab)[ pos ]);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set the dependencies of all type1 entities from a connectivity table,      */
+/* entity i depending on Table[ i * NmbPerEntity + j ], null ones are skipped */
+/*----------------------------------------------------------------------------*/
+
+int AddDependencyTable32( int64_t ParIdx, int TypIdx1, int TypIdx2,
+                          int NmbPerEntity, int32_t *Table )
+{
+   return(AddTab((ParSct *)ParIdx, LplInt, TypIdx1, TypIdx2, NmbPerEntity, Table));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Same as above with a table of 64 bit indices                               */
+/*----------------------------------------------------------------------------*/
+
+int AddDependencyTable64( int64_t ParIdx, int TypIdx1, int TypIdx2,
+                          int NmbPerEntity, int64_t *Table )
+{
+   return(AddTab((ParSct *)ParIdx, LplLng, TypIdx1, TypIdx2, NmbPerEntity, Table));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set the dependencies from a table of indices of the given width            */
+/*----------------------------------------------------------------------------*/
+
+static int AddTab( ParSct *par, int wid, int TypIdx1, int TypIdx2,
+                   int NmbPerEntity, void *Table )
+{
+   int         i, k;
+   TypSct      *typ1;
+   DepArgSct   arg;
+
+   // Get and check lib parallel instance and types,
+   // they must be the ones of the current BeginDependency()
+   if( !par || !Table || (NmbPerEntity < 1) || (TypIdx1 < 1)
+   ||  (TypIdx1 > MaxTyp) || (TypIdx2 < 1) || (TypIdx2 > MaxTyp)
+   ||  (par->CurTyp != &par->TypTab[ TypIdx1 ])
+   ||  !par->CurTyp->SmlWrkSiz || !par->CurTyp->DepWrkSiz )
+   {
+      return(0);
+   }
+
+   typ1 = par->CurTyp;
+   if((k = GetDepTyp(typ1, TypIdx2)) < 0)
+      return(0);
+
+   // Each thread sets the bits of its own range of WP,
+   // counts them and sums the statistics of EndDependency()
+   arg.typ = typ1;
+   arg.tab = Table;
+   arg.IdxWid = wid;
+   arg.NmbPer = NmbPerEntity;
+   arg.NmbLin2 = par->TypTab[ TypIdx2 ].NmbLin;
+   arg.BitOff = typ1->DepBitOff[k];
+   arg.BitLst = typ1->DepBitLst[k];
+   arg.BlkSiz = k ? typ1->DepBlkSiz[k] : typ1->DepWrkSiz;
+   arg.tot = par->PthCnt;
+   arg.max = &par->PthCnt[ par->NmbCpu ];
+
+   for(i=0;i<par->NmbCpu;i++)
+      arg.tot[i] = arg.max[i] = 0;
+
+   par->prc = AddDepTab;
+   par->arg = &arg;
+   TemLch(par, NULL, 1, typ1->NmbSmlWrk, par->NmbCpu, 1);
+
+   typ1->DepTot = typ1->DepMax = 0;
+
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      typ1->DepTot += arg.tot[i];
+      typ1->DepMax = MAX(typ1->DepMax, arg.max[i]);
+   }
+
+   typ1->DepFus = 1;
+
+   return(typ1->DepTot);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set and count the dependency bits of a range of WP from the table          */
+/*----------------------------------------------------------------------------*/
+
+static void AddDepTab(itg BegIdx, itg EndIdx, int PthIdx, void *ptr)
+{
+   int         j, w;
+   itg         i, idx;
+   DepArgSct   *arg = (DepArgSct *)ptr;
+   TypSct      *typ = arg->typ;
+   WrkSct      *wrk;
+
+   for(w=(int)BegIdx-1; w<EndIdx; w++)
+   {
+      wrk = &typ->SmlWrkTab[w];
+
+      for(i=wrk->BegIdx; i<=wrk->EndIdx; i++)
+         for(j=0;j<arg->NmbPer;j++)
+         {
+            idx = GetIdx(arg->tab, arg->IdxWid, i * arg->NmbPer + j);
+
+            if( (idx >= 1) && (idx <= arg->NmbLin2) )
+               SetBit(wrk->DepWrdTab, MIN(arg->BitLst,
+                      arg->BitOff + (int)((idx - 1) / arg->BlkSiz)));
+         }
+
+      wrk->NmbDep = CntBit(typ->NmbDepWrd, wrk->DepWrdTab);
+      arg->tot[ PthIdx ] += wrk->NmbDep;
+      arg->max[ PthIdx ] = MAX(arg->max[ PthIdx ], wrk->NmbDep);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Type1 element idx1 depends on type2 element idx2                           */
+/*----------------------------------------------------------------------------*/
+
+int UpdateDependency(int64_t ParIdx, int TypIdx1, int TypIdx2,
+                     itg idx1, itg idx2 )
+{
+   int    bit;
+   WrkSct *wrk;
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ1, *typ2;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0);
+
+   // Check bounds
+   typ1 = &par->TypTab[ TypIdx1 ];
+   typ2 = &par->TypTab[ TypIdx2 ];
+
+   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
+   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin || !typ2->NmbLin
+   ||  !typ1->SmlWrkSiz || !typ1->DepWrkSiz || (idx1 < 1)
+   ||  (idx1 > typ1->NmbLin) || (idx2 < 1) || (idx2 > typ2->NmbLin) )
+   {
+      return(0);
+   }
+
+   // Type2 must be one of the types the dependencies were set against
+   if((bit = GetDepBit(typ1, TypIdx2, idx2)) < 0)
+      return(0);
+
+   // Schedules derived from the dependencies must be rebuilt
+   ChgWrk(typ1);
+
+   // Dependencies of adaptive blocks are stored in the tree's leaves,
+   // lines beyond the leaves require the plain blocks to be restored
+   if(typ1->NodTab && (GetSmlIdx(typ1, idx1) >= typ1->NmbLef))
+      RstLef(par, typ1);
+
+   if(typ1->NodTab)
+      return(SetNodBit(typ1, GetSmlIdx(typ1, idx1), bit));
+
+   // GetSmlIdx() needs the blocks in index order
+   IdxSmlWrk(typ1);
+
+   // Set and count dependency bit
+   wrk = &typ1->SmlWrkTab[ GetSmlIdx(typ1, idx1) ];
+
+   if(!SetBit(wrk->DepWrdTab, bit))
+      wrk->NmbDep++;
+
+   return(wrk->NmbDep);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Same as above, without any pre-checking of data, 32 bit indices            */
+/*----------------------------------------------------------------------------*/
+
+void UpdateDependencyFast32( int64_t ParIdx,  int TypIdx1, int NmbTyp1,
+                             int32_t *TabIdx1, int TypIdx2, int NmbTyp2,
+                             int32_t *TabIdx2 )
+{
+   UpdFst((ParSct *)ParIdx, LplInt, TypIdx1, NmbTyp1, TabIdx1, TypIdx2, NmbTyp2, TabIdx2);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Same as above, without any pre-checking of data, 64 bit indices            */
+/*----------------------------------------------------------------------------*/
+
+void UpdateDependencyFast64( int64_t ParIdx,  int TypIdx1, int NmbTyp1,
+                             int64_t *TabIdx1, int TypIdx2, int NmbTyp2,
+                             int64_t *TabIdx2 )
+{
+   UpdFst((ParSct *)ParIdx, LplLng, TypIdx1, NmbTyp1, TabIdx1, TypIdx2, NmbTyp2, TabIdx2);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Update the dependencies from tables of indices of the given width          */
+/*----------------------------------------------------------------------------*/
+
+static void UpdFst( ParSct *par, int wid, int TypIdx1, int NmbTyp1,
+                    void *TabIdx1, int TypIdx2, int NmbTyp2, void *TabIdx2 )
+{
+   int i, j;
+   TypSct *typ1 = &par->TypTab[ TypIdx1 ];
+   WrkSct *wrk;
+
+   // Type2 must be one of the types the dependencies were set against
+   if(GetDepTyp(typ1, TypIdx2) < 0)
+      return;
+
+   ChgWrk(typ1);
+
+   for(i=0;i<NmbTyp1;i++)
+   {
+      if(typ1->NodTab && (GetSmlIdx(typ1, GetIdx(TabIdx1, wid, i)) >= typ1->NmbLef))
+         RstLef(par, typ1);
+
+      if(typ1->NodTab)
+      {
+         for(j=0;j<NmbTyp2;j++)
+            SetNodBit(typ1, GetSmlIdx(typ1, GetIdx(TabIdx1, wid, i)),
+                     GetDepBit(typ1, TypIdx2, GetIdx(TabIdx2, wid, j)));
+
+         continue;
+      }
+
+      IdxSmlWrk(typ1);
+
+      wrk = &typ1->SmlWrkTab[ GetSmlIdx(typ1, GetIdx(TabIdx1, wid, i)) ];
+
+      for(j=0;j<NmbTyp2;j++)
+         if( !SetBit(wrk->DepWrdTab, GetDepBit(typ1, TypIdx2, GetIdx(TabIdx2, wid, j))) )
+            wrk->NmbDep++;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sort wp depending on their number of dependencies                          */
+/*----------------------------------------------------------------------------*/
+
+int EndDependency(int64_t ParIdx, float DepSta[2])
+{
+   int      i, NmbDepBit, TotNmbDep = 0;
+   ParSct   *par = (ParSct *)ParIdx;
+   TypSct   *typ1, *typ2;
+
+   // Get and check lib parallel instance
+   if( !ParIdx || !DepSta )
+      return(0);
+
+   // Compute average number of collisions
+   DepSta[1] = 0.;
+   typ1 = par->CurTyp;
+   typ2 = par->DepTyp;
+
+   if(!typ1 || !typ2 || !typ1->DepWrkSiz)
+      return(0);
+
+   // The statistics were already summed by AddDependencyTable()
+   if(typ1->DepFus)
+   {
+      TotNmbDep = typ1->DepTot;
+      DepSta[1] = (float)typ1->DepMax;
+   }
+   else
+   {
+      for(i=0;i<typ1->NmbSmlWrk;i++)
+      {
+         TotNmbDep += typ1->SmlWrkTab[i].NmbDep;
+
+         if(typ1->SmlWrkTab[i].NmbDep > DepSta[1])
+            DepSta[1] = (float)typ1->SmlWrkTab[i].NmbDep;
+      }
+   }
+
+   if(!TotNmbDep)
+      return(0);
+
+   DepSta[0] = (float)TotNmbDep;
+
+   // Compute stats over all the dependency types
+   NmbDepBit = CntDepBit(par, typ1);
+
+   if(!NmbDepBit)
+      return(0);
+
+   DepSta[0] = 100 * DepSta[0] / (typ1->NmbSmlWrk * NmbDepBit);
+   DepSta[1] = 100 * DepSta[1] / NmbDepBit;
+
+   // Sort WP from highest collision number to the lowest
+   typ1->SrtFlg = par->WrkSizSrt && par->DynSch && !typ1->OrdDep;
+
+   // Adaptive blocks are set and sorted from the tree
+   if(typ1->AdpLvl)
+   {
+      if(!NewNod(par, typ1))
+         return(0);
+   }
+   else if(typ1->SrtFlg)
+   {
+      SetPri(typ1);
+      qsort(typ1->SmlWrkTab, typ1->NmbSmlWrk, sizeof(WrkSct), CmpWrk);
+      typ1->SrtUpd = 0;
+   }
+
+   // Build the precedence graph of ordered dependencies
+   if(typ1->OrdDep && !SetOrd(par, typ1))
+      return(0);
+
+   // If the dynamic scheduling is disabled, set static WP,
+   // unless LoadDependencies() is about to read them
+   if( !par->DynSch && !par->LodGrp
+   &&  !(typ1->OrdDep ? SetOrdGrp(par, typ1) : SetGrp(par, typ1)) )
+   {
+      return(0);
+   }
+
+   UpdMem(par, (int)(typ1 - par->TypTab));
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sort wp depending on their number of dependencies                          */
+/*----------------------------------------------------------------------------*/
+
+void GetDependencyStats(int64_t ParIdx, int TypIdx1,
+                        int TypIdx2, float DepSta[2])
+{
+   int i, NmbDepBit, TotNmbDep = 0;
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ1, *typ2;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return;
+
+   // Check bounds
+   typ1 = &par->TypTab[ TypIdx1 ];
+   typ2 = &par->TypTab[ TypIdx2 ];
+
+   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
+   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
+   ||  !typ2->NmbLin )
+   {
+      return;
+   }
+
+   // Compute average number of collisions
+   DepSta[1] = 0.;
+
+   for(i=0;i<typ1->NmbSmlWrk;i++)
+   {
+      TotNmbDep += typ1->SmlWrkTab[i].NmbDep;
+
+      if(typ1->SmlWrkTab[i].NmbDep > DepSta[1])
+         DepSta[1] = (float)typ1->SmlWrkTab[i].NmbDep;
+   }
+
+   DepSta[0] = (float)TotNmbDep;
+
+   // Compute stats
+   if(typ1->NmbDepTyp > 1)
+      NmbDepBit = CntDepBit(par, typ1);
+   else if(typ2->NmbLin >= typ1->DepWrkSiz)
+   {
+      NmbDepBit = typ2->NmbLin / typ1->DepWrkSiz;
+
+      if(typ2->NmbLin - NmbDepBit * typ1->DepWrkSiz)
+         NmbDepBit++;
+   }
+   else
+      NmbDepBit = 1;
+
+   DepSta[0] = 100 * DepSta[0] / (typ1->NmbSmlWrk * NmbDepBit);
+   DepSta[1] = 100 * DepSta[1] / NmbDepBit;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Hash a connectivity table as the sum of its entities' hashes, which does   */
+/* not depend on the way the table is shared among threads                    */
+/*----------------------------------------------------------------------------*/
+
+uint64_t ConnectivityChecksum32(int64_t ParIdx, int64_t NmbEntity,
+                                int NmbPerEntity, int32_t *Table )
+{
+   return(ChkSum((ParSct *)ParIdx, LplInt, NmbEntity, NmbPerEntity, Table));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Same as above with a table of 64 bit indices, which gives the same hash    */
+/*----------------------------------------------------------------------------*/
+
+uint64_t ConnectivityChecksum64(int64_t ParIdx, int64_t NmbEntity,
+                                int NmbPerEntity, int64_t *Table )
+{
+   return(ChkSum((ParSct *)ParIdx, LplLng, NmbEntity, NmbPerEntity, Table));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Hash a table of indices of the given width                                 */
+/*----------------------------------------------------------------------------*/
+
+static uint64_t ChkSum( ParSct *par, int wid, itg NmbEntity,
+                        int NmbPerEntity, void *Table )
+{
+   int      i;
+   uint64_t sum = 0;
+   ChkSct   chk;
+
+   if(!par || !Table || (NmbEntity < 1) || (NmbPerEntity < 1))
+      return(0);
+
+   chk.tab = Table;
+   chk.IdxWid = wid;
+   chk.NmbPer = NmbPerEntity;
+   chk.sum = par->PthSum;
+
+   for(i=0;i<par->NmbCpu;i++)
+      chk.sum[i] = 0;
+
+   par->prc = ChkTab;
+   par->arg = &chk;
+   TemLch(par, NULL, 1, NmbEntity, par->NmbCpu, 1);
+
+   for(i=0;i<par->NmbCpu;i++)
+      sum += chk.sum[i];
+
+   return(sum);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sum the hashes of a range of entities and their connectivity               */
+/*----------------------------------------------------------------------------*/
+
+static void ChkTab(itg BegIdx, itg EndIdx, int PthIdx, void *ptr)
+{
+   int      j;
+   itg      i;
+   uint64_t h;
+   ChkSct   *chk = (ChkSct *)ptr;
+
+   for(i=BegIdx; i<=EndIdx; i++)
+   {
+      h = MixHsh((uint64_t)i);
+
+      for(j=0;j<chk->NmbPer;j++)
+         h = MixHsh(h ^ (uint64_t)GetIdx(chk->tab, chk->IdxWid, i * chk->NmbPer + j));
+
+      chk->sum[ PthIdx ] += h;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Scramble the bits of a 64 bit word                                         */
+/*----------------------------------------------------------------------------*/
+
+static uint64_t MixHsh(uint64_t h)
+{
+   h += 0x9e3779b97f4a7c15ULL;
+   h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+   h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+
+   return(h ^ (h >> 31));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Write a type's dependencies in a binary file: a header keyed by the types' */
+/* sizes and the user's connectivity key, the dependency words of each WP in  */
+/* index order and, with static scheduling, the WP of each group              */
+/*----------------------------------------------------------------------------*/
+
+int SaveDependencies(int64_t ParIdx, int TypIdx1, char *FilNam, uint64_t key)
+{
+   int      i, j, t, n, NmbWrk, *WrdTab, err = 0;
+   int64_t  hdr[ DepHdrSiz ] = {0};
+   char     tag[16] = "LPlibDependency";
+   FILE     *hdl;
+   GrpSct   *grp;
+   TypSct   *typ;
+   WrkSct   **WrkTab;
+   ParSct   *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance, type and file name
+   if( !ParIdx || !FilNam || (TypIdx1 < 1) || (TypIdx1 > MaxTyp)
+   ||  !par->TypTab[ TypIdx1 ].DepWrdMat || !par->TypTab[ TypIdx1 ].NmbDepTyp )
+   {
+      return(0);
+   }
+
+   typ = &par->TypTab[ TypIdx1 ];
+
+   // The leaves of an adaptive tree are the blocks BeginDependency() sets
+   NmbWrk = typ->NodTab ? typ->NmbLef : typ->NmbSmlWrk;
+
+   WrdTab = LPL_malloc(par->lmb, (typ->NmbDepWrd + 1) * sizeof(int));
+   WrkTab = LPL_malloc(par->lmb, typ->NmbSmlWrk * sizeof(WrkSct *));
+
+   if(!WrdTab || !WrkTab || !(hdl = fopen(FilNam, "wb")))
+   {
+      if(WrdTab)
+         LPL_free(par->lmb, WrdTab);
+
+      if(WrkTab)
+         LPL_free(par->lmb, WrkTab);
+
+      return(0);
+   }
+
+   hdr[0] = DepFilVer;
+   hdr[1] = sizeof(itg);
+   hdr[2] = (int64_t)key;
+   hdr[3] = typ->NmbLin;
+   hdr[4] = NmbWrk;
+   hdr[5] = typ->NmbDepWrd;
+   hdr[6] = typ->DepWrkSiz;
+   hdr[7] = typ->NmbDepTyp;
+   hdr[8] = par->NmbCpu;
+   hdr[9] = typ->NexGrp ? typ->NmbGrp : 0;
+   hdr[10] = WrkPerGrp;
+
+   for(i=0;i<typ->NmbDepTyp;i++)
+   {
+      hdr[ 11 + 4*i     ] = typ->DepTypIdx[i];
+      hdr[ 11 + 4*i + 1 ] = par->TypTab[ typ->DepTypIdx[i] ].NmbLin;
+      hdr[ 11 + 4*i + 2 ] = i ? typ->DepBlkSiz[i] : typ->DepWrkSiz;
+      hdr[ 11 + 4*i + 3 ] = typ->DepBitOff[i];
+   }
+
+   err |= (fwrite(tag, sizeof(tag), 1, hdl) != 1);
+   err |= (fwrite(hdr, sizeof(int64_t), DepHdrSiz, hdl) != DepHdrSiz);
+
+   // Write the dependencies of the WP in index order
+   for(i=0;i<typ->NmbSmlWrk;i++)
+      WrkTab[i] = &typ->SmlWrkTab[i];
+
+   qsort(WrkTab, typ->NmbSmlWrk, sizeof(WrkSct *), CmpPtr);
+
+   for(i=0;i<NmbWrk;i++)
+   {
+      if(typ->NodTab)
+      {
+         WrdTab[0] = typ->NodTab[i].NmbDep;
+         CpyWrd(typ->NmbDepWrd, typ->NodTab[i].DepWrdTab, &WrdTab[1]);
+      }
+      else
+      {
+         WrdTab[0] = WrkTab[i]->NmbDep;
+         CpyWrd(typ->NmbDepWrd, WrkTab[i]->DepWrdTab, &WrdTab[1]);
+      }
+
+      err |= (fwrite(WrdTab, sizeof(int), typ->NmbDepWrd + 1, hdl) != (size_t)typ->NmbDepWrd + 1);
+   }
+
+   // Then each thread's part of the static groups as WP positions
+   for(grp = typ->NexGrp; grp; grp = grp->nex)
+      for(t=0;t<par->NmbCpu;t++)
+      {
+         n = grp->NmbSmlWrk[t];
+         err |= (fwrite(&n, sizeof(int), 1, hdl) != 1);
+
+         for(j=0;j<n;j++)
+         {
+            WrdTab[0] = (int)(grp->SmlWrkTab[t][j] - typ->SmlWrkTab);
+            err |= (fwrite(WrdTab, sizeof(int), 1, hdl) != 1);
+         }
+      }
+
+   LPL_free(par->lmb, WrdTab);
+   LPL_free(par->lmb, WrkTab);
+
+   // A truncated file, on a full disk for instance, is removed
+   // instead of being left for a later load to reject
+   err |= (fclose(hdl) != 0);
+
+   if(err)
+   {
+      remove(FilNam);
+      return(0);
+   }
+
+   return(NmbWrk);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set a type's dependencies from a file written by SaveDependencies(),       */
+/* provided the types' sizes, the key and the blocks' sizes still match       */
+/*----------------------------------------------------------------------------*/
+
+int LoadDependencies(int64_t ParIdx, int TypIdx1, char *FilNam,
+                     uint64_t key, float DepSta[2] )
+{
+   int      i, k, NmbTyp, TypTab[ MaxDepTyp ], *WrdTab = NULL, res = 0;
+   int64_t  hdr[ DepHdrSiz ];
+   char     tag[16];
+   FILE     *hdl;
+   TypSct   *typ;
+   WrkSct   **WrkTab = NULL;
+   ParSct   *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance, type and file name
+   if( !ParIdx || !FilNam || !DepSta || (TypIdx1 < 1) || (TypIdx1 > MaxTyp)
+   ||  !(hdl = fopen(FilNam, "rb")) )
+   {
+      return(0);
+   }
+
+   typ = &par->TypTab[ TypIdx1 ];
+
+   // Check the file's version, indices' size, key and types' sizes
+   if( (fread(tag, sizeof(tag), 1, hdl) != 1) || strcmp(tag, "LPlibDependency")
+   ||  (fread(hdr, sizeof(int64_t), DepHdrSiz, hdl) != DepHdrSiz)
+   ||  (hdr[0] != DepFilVer) || ((hdr[1] != LplInt) && (hdr[1] != LplLng))
+   ||  (hdr[2] != (int64_t)key)
+   ||  (hdr[3] != typ->NmbLin) || (hdr[7] < 1) || (hdr[7] > MaxDepTyp) )
+   {
+      fclose(hdl);
+      return(0);
+   }
+
+   NmbTyp = (int)hdr[7];
+
+   for(i=0;i<NmbTyp;i++)
+   {
+      TypTab[i] = (int)hdr[ 11 + 4*i ];
+
+      if( (TypTab[i] < 1) || (TypTab[i] > MaxTyp)
+      ||  (par->TypTab[ TypTab[i] ].NmbLin != hdr[ 11 + 4*i + 1 ]) )
+      {
+         fclose(hdl);
+         return(0);
+      }
+   }
+
+   // Set the blocks as a regular dependency loop would and make sure
+   // they are the same as the saved ones
+   if(!BeginDependencyMultiType(ParIdx, TypIdx1, NmbTyp, TypTab))
+   {
+      fclose(hdl);
+      return(0);
+   }
+
+   if( (typ->NmbSmlWrk != hdr[4]) || (typ->NmbDepWrd != hdr[5])
+   ||  (typ->DepWrkSiz != hdr[6]) )
+   {
+      goto LodEnd;
+   }
+
+   for(k=1;k<NmbTyp;k++)
+      if( (typ->DepBlkSiz[k] != hdr[ 11 + 4*k + 2 ])
+      ||  (typ->DepBitOff[k] != hdr[ 11 + 4*k + 3 ]) )
+      {
+         goto LodEnd;
+      }
+
+   WrdTab = LPL_malloc(par->lmb, (typ->NmbDepWrd + 1) * sizeof(int));
+   WrkTab = LPL_malloc(par->lmb, typ->NmbSmlWrk * sizeof(WrkSct *));
+
+   if(!WrdTab || !WrkTab)
+      goto LodEnd;
+
+   for(i=0;i<typ->NmbSmlWrk;i++)
+      WrkTab[i] = &typ->SmlWrkTab[i];
+
+   qsort(WrkTab, typ->NmbSmlWrk, sizeof(WrkSct *), CmpPtr);
+
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      if(fread(WrdTab, sizeof(int), typ->NmbDepWrd + 1, hdl) != (size_t)typ->NmbDepWrd + 1)
+         goto LodEnd;
+
+      WrkTab[i]->NmbDep = WrdTab[0];
+      CpyWrd(typ->NmbDepWrd, &WrdTab[1], WrkTab[i]->DepWrdTab);
+   }
+
+   // Sort the WP and build the schedules as EndDependency() does, only the
+   // static groups are read from the file if they fit the number of threads
+   par->LodGrp = !par->DynSch && hdr[9] && (hdr[8] == par->NmbCpu)
+               && (hdr[10] == WrkPerGrp) && !typ->OrdDep;
+
+   if(!EndDependency(ParIdx, DepSta))
+      goto LodEnd;
+
+   if(par->LodGrp)
+   {
+      if(!LodGrp(par, typ, hdl, (int)hdr[9]) || !SetGrpWai(par, typ))
+      {
+         FreGrp(par, typ);
+         goto LodEnd;
+      }
+   }
+
+   res = typ->NmbSmlWrk;
+
+   LodEnd:
+
+   par->LodGrp = 0;
+   fclose(hdl);
+
+   // Do not leave a half-built dependency state behind,
+   // the dependencies are then to be rebuilt from scratch
+   if(!res)
+   {
+      FreDep(par, typ);
+      par->CurTyp = par->DepTyp = NULL;
+   }
+
+   if(WrdTab)
+      LPL_free(par->lmb, WrdTab);
+
+   if(WrkTab)
+      LPL_free(par->lmb, WrkTab);
+
+   return(res);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Read the static groups' WP positions                                       */
+/*----------------------------------------------------------------------------*/
+
+static int LodGrp(ParSct *par, TypSct *typ, FILE *hdl, int NmbGrp)
+{
+   int      i, j, t, n, w;
+   GrpSct   *grp, *LstGrp = NULL;
+
+   FreGrp(par, typ);
+   typ->NmbGrp = NmbGrp;
+
+   for(i=1;i<=NmbGrp;i++)
+   {
+      if(!(grp = NewGrp(par)))
+         return(0);
+
+      grp->idx = i;
+
+      if(LstGrp)
+         LstGrp->nex = grp;
+      else
+         typ->NexGrp = grp;
+
+      LstGrp = grp;
+
+      for(t=0;t<par->NmbCpu;t++)
+      {
+         if( (fread(&n, sizeof(int), 1, hdl) != 1) || (n < 0) || (n > WrkPerGrp) )
+            return(0);
+
+         for(j=0;j<n;j++)
+         {
+            if( (fread(&w, sizeof(int), 1, hdl) != 1)
+            ||  (w < 0) || (w >= typ->NmbSmlWrk) )
+            {
+               return(0);
+            }
+
+            grp->SmlWrkTab[t][j] = &typ->SmlWrkTab[w];
+         }
+
+         grp->NmbSmlWrk[t] = n;
+      }
+   }
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Halve the number of small blocks by compining pairs of consecutive blocks  */
+/*----------------------------------------------------------------------------*/
+
+int HalveSmallBlocks(int64_t ParIdx, int TypIdx1, int TypIdx2)
+{
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ1, *typ2;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0);
+
+   // Check bounds
+   typ1 = &par->TypTab[ TypIdx1 ];
+   typ2 = &par->TypTab[ TypIdx2 ];
+
+   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
+   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
+   ||  !typ2->NmbLin )
+   {
+      return(0);
+   }
+
+   // Do not halve the number of blocks if the small blocks have been sorted
+   if(par->WrkSizSrt)
+      return(0);
+
+   return(HlvSml(typ1));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Merge pairs of consecutive small WP and OR their dependency words          */
+/*----------------------------------------------------------------------------*/
+
+static int HlvSml(TypSct *typ)
+{
+   int i, j;
+   WrkSct *EvnWrk, *OddWrk, *NewWrk;
+
+   // Do not halve the number of blocks if there is only one left
+   // or if they are already adapted through a tree
+   if( (typ->NmbSmlWrk < 2) || typ->NodTab )
+      return(0);
+
+   ChgWrk(typ);
+
+   // Sorted WP must be put back in index order so that pairs are consecutive
+   if(typ->SrtFlg)
+      qsort(typ->SmlWrkTab, typ->NmbSmlWrk, sizeof(WrkSct), CmpBeg);
+
+   // For each new block, compute the logical OR between two consecutive old blocks
+   // The new data is copied on top of former one
+   for(i=0;i<typ->NmbSmlWrk;i+=2)
+   {
+      EvnWrk = &typ->SmlWrkTab[ i     ];
+      OddWrk = &typ->SmlWrkTab[ i + 1 ];
+      NewWrk = &typ->SmlWrkTab[ i / 2 ];
+      NewWrk->BegIdx = EvnWrk->BegIdx;
+
+      if(i+1 < typ->NmbSmlWrk)
+         NewWrk->EndIdx = OddWrk->EndIdx;
+      else
+         NewWrk->EndIdx = EvnWrk->EndIdx;
+
+      for(j=0;j<typ->NmbDepWrd;j++)
+         if(i+1 < typ->NmbSmlWrk)
+            NewWrk->DepWrdTab[j] = EvnWrk->DepWrdTab[j] | OddWrk->DepWrdTab[j];
+         else
+            NewWrk->DepWrdTab[j] = EvnWrk->DepWrdTab[j];
+
+      NewWrk->NmbDep = CntBit(typ->NmbDepWrd, NewWrk->DepWrdTab);
+   }
+
+   // Halve the number of blocks and add one if the number was odd
+   typ->SmlWrkSiz *= typ->NmbSmlWrk;
+
+   if(typ->NmbSmlWrk & 1)
+      typ->NmbSmlWrk = typ->NmbSmlWrk / 2 + 1;
+   else
+      typ->NmbSmlWrk /= 2;
+
+   typ->SmlWrkSiz /= typ->NmbSmlWrk;
+   typ->SmlLvl++;
+   typ->CstShf++;
+
+   if(typ->SrtFlg)
+   {
+      SetPri(typ);
+      qsort(typ->SmlWrkTab, typ->NmbSmlWrk, sizeof(WrkSct), CmpWrk);
+      typ->SrtUpd = 0;
+   }
+
+   return(typ->NmbSmlWrk);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Halve the number of dependency words by ORing consecutive pairs of bits    */
+/*----------------------------------------------------------------------------*/
+
+int HalveDependencyBlocks(int64_t ParIdx, int TypIdx1, int TypIdx2)
+{
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ1, *typ2;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0);
+
+   // Check bounds
+   typ1 = &par->TypTab[ TypIdx1 ];
+   typ2 = &par->TypTab[ TypIdx2 ];
+
+   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
+   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
+   ||  !typ2->NmbLin )
+   {
+      return(0);
+   }
+
+   return(HlvDep(typ1));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* OR pairs of consecutive dependency bits of every small WP                  */
+/*----------------------------------------------------------------------------*/
+
+static int HlvDep(TypSct *typ)
+{
+   int i, j, NmbBit = typ->NmbDepWrd * 32;
+   WrkSct *wrk;
+
+   // Do not halve the number of blocks if there is only one left,
+   // if the tree's nodes rely on the current dependency blocks
+   // or if pairs of bits could straddle two dependency types
+   if( (typ->NmbDepWrd < 2) || typ->NodTab || (typ->NmbDepTyp > 1) )
+      return(0);
+
+   ChgWrk(typ);
+
+   // Bits are processed in increasing order so that a new bit j/2
+   // is always written after the old bits j and j+1 have been read
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      wrk = &typ->SmlWrkTab[i];
+
+      for(j=0;j<NmbBit;j+=2)
+         if(GetBit(wrk->DepWrdTab, j) || GetBit(wrk->DepWrdTab, j+1))
+            SetBit(wrk->DepWrdTab, j/2);
+         else
+            ClrBit(wrk->DepWrdTab, j/2);
+   }
+
+   typ->DepWrkSiz *= typ->NmbDepWrd;
+
+   if(typ->NmbDepWrd & 1)
+      typ->NmbDepWrd = typ->NmbDepWrd / 2 + 1;
+   else
+      typ->NmbDepWrd /= 2;
+
+   typ->DepWrkSiz /= typ->NmbDepWrd;
+   typ->DepLvl++;
+
+   // Clear the bits left over in the last word and update the dependency counts
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      wrk = &typ->SmlWrkTab[i];
+
+      for(j=NmbBit/2;j<typ->NmbDepWrd * 32;j++)
+         ClrBit(wrk->DepWrdTab, j);
+
+      wrk->NmbDep = CntBit(typ->NmbDepWrd, wrk->DepWrdTab);
+   }
+
+   return(typ->NmbDepWrd * 32);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build a binary tree whose leaves are the small WP and whose nodes merge    */
+/* consecutive blocks, the initial WP being the nodes NmbAdpLvl levels up     */
+/*----------------------------------------------------------------------------*/
+
+static int NewNod(ParSct *par, TypSct *typ)
+{
+   int      i, j, n, lvl = 0, *LvlTab;
+   NodSct   *nod, *son0, *son1;
+
+   n = typ->NmbLef = typ->NmbSmlWrk;
+   typ->NmbNod = 2 * n - 1;
+
+   // Release the tables already allocated if one of them fails,
+   // the requested level is kept for the next EndDependency
+   if( !(typ->NodTab = LPL_calloc(par->lmb, typ->NmbNod, sizeof(NodSct)))
+   ||  !(typ->NodDepMat = AlcHug(par->lmb, (int64_t)typ->NmbNod * typ->NmbDepWrd * sizeof(int),
+                                 LplHugePages | LplClearMemory))
+   ||  !(LvlTab = LPL_malloc(par->lmb, n * sizeof(int))) )
+   {
+      lvl = typ->AdpLvl;
+      FreNod(par, typ);
+      typ->AdpLvl = lvl;
+      return(0);
+   }
+
+   // Copy the small WP, still in index order, as leaves
+   for(i=0;i<typ->NmbNod;i++)
+   {
+      nod = &typ->NodTab[i];
+      nod->DepWrdTab = &typ->NodDepMat[ i * typ->NmbDepWrd ];
+      nod->son[0] = nod->son[1] = nod->fat = -1;
+   }
+
+   for(i=0;i<n;i++)
+   {
+      nod = &typ->NodTab[i];
+      nod->BegIdx = typ->SmlWrkTab[i].BegIdx;
+      nod->EndIdx = typ->SmlWrkTab[i].EndIdx;
+      nod->NmbDep = typ->SmlWrkTab[i].NmbDep;
+      nod->act = !typ->AdpLvl;
+      CpyWrd(typ->NmbDepWrd, typ->SmlWrkTab[i].DepWrdTab, nod->DepWrdTab);
+      LvlTab[i] = i;
+   }
+
+   // Merge pairs of consecutive nodes level by level,
+   // an odd last node is carried up to the next level as is
+   typ->RooNod = 0;
+   typ->NmbNod = n;
+
+   while(n > 1)
+   {
+      lvl++;
+
+      for(i=0;i<n;i+=2)
+      {
+         if(i+1 == n)
+         {
+            LvlTab[ i/2 ] = LvlTab[i];
+            continue;
+         }
+
+         nod = &typ->NodTab[ typ->NmbNod ];
+         son0 = &typ->NodTab[ LvlTab[i] ];
+         son1 = &typ->NodTab[ LvlTab[i+1] ];
+         nod->BegIdx = son0->BegIdx;
+         nod->EndIdx = son1->EndIdx;
+         nod->son[0] = LvlTab[i];
+         nod->son[1] = LvlTab[i+1];
+         son0->fat = son1->fat = typ->NmbNod;
+
+         for(j=0;j<typ->NmbDepWrd;j++)
+            nod->DepWrdTab[j] = son0->DepWrdTab[j] | son1->DepWrdTab[j];
+
+         nod->NmbDep = CntBit(typ->NmbDepWrd, nod->DepWrdTab);
+         LvlTab[ i/2 ] = typ->NmbNod++;
+      }
+
+      n = (n + 1) / 2;
+
+      if(lvl == typ->AdpLvl)
+         for(i=0;i<n;i++)
+            typ->NodTab[ LvlTab[i] ].act = 1;
+   }
+
+   typ->RooNod = LvlTab[0];
+
+   // Not enough leaves to reach the requested level: start from the root
+   if(lvl < typ->AdpLvl)
+      typ->NodTab[ typ->RooNod ].act = 1;
+
+   LPL_free(par->lmb, LvlTab);
+
+   SetAdpWrk(typ);
+
+   // The number of initial WP is the target the adaptation will stick to
+   typ->NmbTgt = typ->NmbSmlWrk;
+   UpdMem(par, (int)(typ - par->TypTab));
+
+   return(typ->NmbNod);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set the small WP from the tree's active nodes                              */
+/*----------------------------------------------------------------------------*/
+
+static void SetAdpWrk(TypSct *typ)
+{
+   int NmbWrk = 0;
+
+   AddAdpWrk(typ, typ->RooNod, &NmbWrk);
+   typ->NmbSmlWrk = NmbWrk;
+   typ->AdpUpd = 0;
+   ChgWrk(typ);
+
+   if(typ->SrtFlg)
+   {
+      SetPri(typ);
+      qsort(typ->SmlWrkTab, typ->NmbSmlWrk, sizeof(WrkSct), CmpWrk);
+      typ->SrtUpd = 0;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Recursively copy the active nodes of a sub-tree into WP                    */
+/*----------------------------------------------------------------------------*/
+
+static void AddAdpWrk(TypSct *typ, int NodIdx, int *NmbWrk)
+{
+   NodSct *nod = &typ->NodTab[ NodIdx ];
+   WrkSct *wrk;
+
+   if(!nod->act)
+   {
+      AddAdpWrk(typ, nod->son[0], NmbWrk);
+      AddAdpWrk(typ, nod->son[1], NmbWrk);
+      return;
+   }
+
+   wrk = &typ->SmlWrkTab[ (*NmbWrk)++ ];
+   wrk->BegIdx = nod->BegIdx;
+   wrk->EndIdx = nod->EndIdx;
+   wrk->NmbDep = nod->NmbDep;
+   wrk->NodIdx = NodIdx;
+   wrk->pri = 0.;
+   CpyWrd(typ->NmbDepWrd, nod->DepWrdTab, wrk->DepWrdTab);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Feed the tree with the WP run times and adapt the blocks around the        */
+/* average time the initial number of blocks would give                       */
+/*----------------------------------------------------------------------------*/
+
+static void UpdNod(TypSct *typ)
+{
+   int      i;
+   double   TotTim = 0.;
+   WrkSct   *wrk;
+
+   // The WP stored their run time in their node
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      wrk = &typ->SmlWrkTab[i];
+      TotTim += typ->NodTab[ wrk->NodIdx ].RunTim;
+   }
+
+   if(TotTim <= 0.)
+      return;
+
+   if(AdpNod(typ, typ->RooNod, TotTim / typ->NmbTgt))
+      typ->AdpUpd = 1;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Split the active nodes slower than twice the target time and merge the     */
+/* pairs of active brothers faster than half of it, return the changes count  */
+/*----------------------------------------------------------------------------*/
+
+static int AdpNod(TypSct *typ, int NodIdx, double TgtTim)
+{
+   int      i, NmbChg;
+   NodSct   *nod = &typ->NodTab[ NodIdx ], *son0, *son1;
+
+   // An active node is split one level at a time and its run time
+   // is shared among its sons according to their number of lines
+   if(nod->act)
+   {
+      if( (nod->RunTim <= 2. * TgtTim) || (nod->son[0] < 0) )
+         return(0);
+
+      nod->act = 0;
+
+      for(i=0;i<2;i++)
+      {
+         son0 = &typ->NodTab[ nod->son[i] ];
+         son0->act = 1;
+         son0->RunTim = nod->RunTim * (son0->EndIdx - son0->BegIdx + 1)
+                      / (nod->EndIdx - nod->BegIdx + 1);
+      }
+
+      return(1);
+   }
+
+   NmbChg = AdpNod(typ, nod->son[0], TgtTim) + AdpNod(typ, nod->son[1], TgtTim);
+
+   // The hysteresis between the two thresholds prevents
+   // a merged node from being split right away
+   son0 = &typ->NodTab[ nod->son[0] ];
+   son1 = &typ->NodTab[ nod->son[1] ];
+
+   if(son0->act && son1->act && (son0->RunTim + son1->RunTim < TgtTim / 2.))
+   {
+      son0->act = son1->act = 0;
+      nod->act = 1;
+      nod->RunTim = son0->RunTim + son1->RunTim;
+      NmbChg++;
+   }
+
+   return(NmbChg);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set a dependency bit in a leaf and its ancestors                           */
+/*----------------------------------------------------------------------------*/
+
+static int SetNodBit(TypSct *typ, int LefIdx, int BitIdx)
+{
+   int      NodIdx = LefIdx;
+   NodSct   *nod;
+
+   while(NodIdx >= 0)
+   {
+      nod = &typ->NodTab[ NodIdx ];
+
+      if(!SetBit(nod->DepWrdTab, BitIdx))
+         nod->NmbDep++;
+
+      NodIdx = nod->fat;
+   }
+
+   typ->AdpUpd = 1;
+
+   return(typ->NodTab[ LefIdx ].NmbDep);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set back the small WP from the tree's leaves and free the tree             */
+/*----------------------------------------------------------------------------*/
+
+static void RstLef(ParSct *par, TypSct *typ)
+{
+   int      i;
+   NodSct   *nod;
+   WrkSct   *wrk;
+
+   for(i=0;i<typ->NmbLef;i++)
+   {
+      nod = &typ->NodTab[i];
+      wrk = &typ->SmlWrkTab[i];
+      wrk->BegIdx = nod->BegIdx;
+      wrk->EndIdx = nod->EndIdx;
+      wrk->NmbDep = nod->NmbDep;
+      CpyWrd(typ->NmbDepWrd, nod->DepWrdTab, wrk->DepWrdTab);
+   }
+
+   typ->NmbSmlWrk = typ->NmbLef;
+   ChgWrk(typ);
+   FreNod(par, typ);
+
+   if(typ->SrtFlg)
+   {
+      SetPri(typ);
+      qsort(typ->SmlWrkTab, typ->NmbSmlWrk, sizeof(WrkSct), CmpWrk);
+      typ->SrtUpd = 0;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free a type's tree of adaptive blocks                                      */
+/*----------------------------------------------------------------------------*/
+
+static void FreNod(ParSct *par, TypSct *typ)
+{
+   LPL_free(par->lmb, typ->NodTab);
+
+   if(typ->NodDepMat)
+      FreHug(par->lmb, typ->NodDepMat);
+
+   typ->NodTab = NULL;
+   typ->NodDepMat = NULL;
+   typ->NmbNod = typ->NmbLef = typ->AdpLvl = typ->AdpUpd = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Return a block of elements' begin and ending indices                       */
+/*----------------------------------------------------------------------------*/
+
+int GetBigBlkNfo(int64_t ParIdx, int TypIdx, int BlkIdx, int *BegIdx, int *EndIdx)
+{
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ;
+
+   // Get and check lib parallel instance, type and block indices
+   if(!ParIdx || TypIdx < 1 || TypIdx >= MaxTyp || BlkIdx < 0 || BlkIdx >= par->NmbCpu)
+      return(0);
+
+   // Check if thi type has been allocated
+   typ = &par->TypTab[ TypIdx ];
+
+   if(!typ->NmbLin)
+      return(0);
+
+   // Set begin and end indices
+   *BegIdx = typ->BigWrkTab[ BlkIdx ].ItlTab[0][0];
+   *EndIdx = typ->BigWrkTab[ BlkIdx ].ItlTab[0][1];
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Return the block ID containing the given element ID                        */
+/*----------------------------------------------------------------------------*/
+
+int GetBlkIdx(int64_t ParIdx, int typ, int idx)
+{
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(-1);
+
+   return(GetSmlIdx(&par->TypTab[ typ ], idx));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Check whether two blocks are dependant or not from each others             */
+/*----------------------------------------------------------------------------*/
+
+int ChkBlkDep(int64_t ParIdx, int TypIdx, int blk1, int blk2)
+{
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(-1);
+
+   typ = &par->TypTab[ TypIdx ];
+
+   return(AndWrd( typ->NmbDepWrd,
+                  typ->SmlWrkTab[ blk1 ].DepWrdTab,
+                  typ->SmlWrkTab[ blk2 ].DepWrdTab ));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Test and set a bit in a multibyte word                                     */
+/*----------------------------------------------------------------------------*/
+
+static int SetBit(int *tab, int idx)
+{
+   int res = ( tab[ idx >> 5 ] & (1UL << (idx & 31)) );
+   tab[ idx >> 5 ] |= 1UL << (idx & 31);
+   return(res);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Test a bit in a multibyte word                                             */
+/*----------------------------------------------------------------------------*/
+
+static int GetBit(int *tab, int idx)
+{
+   return( tab[ idx >> 5 ] & (1UL << (idx & 31)) );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Clear a bit in a multibyte word                                            */
+/*----------------------------------------------------------------------------*/
+
+static void ClrBit(int *tab, int idx)
+{
+   tab[ idx >> 5 ] &= ~(1UL << (idx & 31));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Check wether two WP share common resources -> locked                       */
+/*----------------------------------------------------------------------------*/
+
+static int AndWrd(int NmbWrd, int *wrd1, int *wrd2)
+{
+   int i;
+
+   for(i=0;i<NmbWrd;i++)
+      if(wrd1[i] & wrd2[i])
+         return(1);
+
+   return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Logical OR between two multibyte words                                     */
+/*----------------------------------------------------------------------------*/
+
+static void AddWrd(int NmbWrd, int *SrcWrd, int *DstWrd)
+{
+   int i;
+
+   for(i=0;i<NmbWrd;i++)
+      DstWrd[i] |= SrcWrd[i];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Exclusive OR between two multibyte words                                   */
+/*----------------------------------------------------------------------------*/
+
+static void SubWrd(int NmbWrd, int *SrcWrd, int *DstWrd)
+{
+   int i;
+
+   for(i=0;i<NmbWrd;i++)
+      DstWrd[i] &= ~SrcWrd[i];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Clear a multibyte word                                                     */
+/*----------------------------------------------------------------------------*/
+
+static void ClrWrd(int NmbWrd, int *wrd)
+{
+   int i;
+
+   for(i=0;i<NmbWrd;i++)
+      wrd[i] = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Copy a multibyte word into another one                                     */
+/*----------------------------------------------------------------------------*/
+
+static void CpyWrd(int NmbWrd, int *SrcWrd, int *DstWrd)
+{
+   int i;
+
+   for(i=0;i<NmbWrd;i++)
+      DstWrd[i] = SrcWrd[i];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Compare two workpackages priority and number of bits                       */
+/*----------------------------------------------------------------------------*/
+
+int CmpWrk(const void *ptr1, const void *ptr2)
+{
+   WrkSct *w1, *w2;
+
+   w1 = (WrkSct *)ptr1;
+   w2 = (WrkSct *)ptr2;
+
+   if(w1->pri > w2->pri)
+      return(-1);
+   else if(w1->pri < w2->pri)
+      return(1);
+   else if(w1->NmbDep > w2->NmbDep)
+      return(-1);
+   else if(w1->NmbDep < w2->NmbDep)
+      return(1);
+   else
+      return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Compare two workpackages first index                                       */
+/*----------------------------------------------------------------------------*/
+
+static int CmpBeg(const void *ptr1, const void *ptr2)
+{
+   WrkSct *w1, *w2;
+
+   w1 = (WrkSct *)ptr1;
+   w2 = (WrkSct *)ptr2;
+
+   if(w1->BegIdx > w2->BegIdx)
+      return(1);
+   else if(w1->BegIdx < w2->BegIdx)
+      return(-1);
+   else
+      return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Compare the first index of two pointed workpackages                        */
+/*----------------------------------------------------------------------------*/
+
+static int CmpPtr(const void *ptr1, const void *ptr2)
+{
+   WrkSct *w1, *w2;
+
+   w1 = *(WrkSct **)ptr1;
+   w2 = *(WrkSct **)ptr2;
+
+   if(w1->BegIdx > w2->BegIdx)
+      return(1);
+   else if(w1->BegIdx < w2->BegIdx)
+      return(-1);
+   else
+      return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Count the number of bits set in a multibyte word                           */
+/*----------------------------------------------------------------------------*/
+
+static int CntBit(int NmbWrd, int *wrd)
+{
+   int i, NmbBit = 0;
+   unsigned int val;
+
+   for(i=0;i<NmbWrd;i++)
+      for(val = (unsigned int)wrd[i]; val; val &= val - 1)
+         NmbBit++;
+
+   return(NmbBit);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Generate static scheduling groups of small WP for each thread              */
+/*----------------------------------------------------------------------------*/
+
+static int SetGrp(ParSct *par, TypSct *typ)
+{
+   int      i, j, g, t, u, v, w, NmbDon, NmbWrk = typ->NmbSmlWrk, NmbBit = typ->NmbDepWrd * 32;
+   int      NmbVarArg, PrcWid, *BitGrp, *BitPth, *WrkNex, *WrkPrv, *PthHed, *PthTal, *PthCnt;
+   int      res = 0;
+   GrpSct   *grp, *LstGrp;
+   GrpArgSct arg;
+
+   // Free the groups of a former EndDependency
+   FreGrp(par, typ);
+
+   // Allocate the bits' lists of the WP, the last group and thread
+   // that used each bit and the threads' queues of WP
+   arg.typ = typ;
+   arg.WrkBitTab = NULL;
+   arg.WrkBitOff = LPL_malloc(par->lmb, (NmbWrk + 1) * sizeof(int));
+   BitGrp = LPL_malloc(par->lmb, NmbBit * sizeof(int));
+   BitPth = LPL_malloc(par->lmb, NmbBit * sizeof(int));
+   WrkNex = LPL_malloc(par->lmb, NmbWrk * sizeof(int));
+   WrkPrv = LPL_malloc(par->lmb, NmbWrk * sizeof(int));
+   PthHed = LPL_malloc(par->lmb, 3 * par->NmbCpu * sizeof(int));
+
+   if( !arg.WrkBitOff || !BitGrp || !BitPth || !WrkNex || !WrkPrv || !PthHed )
+      goto GrpEnd;
+
+   PthTal = &PthHed[ par->NmbCpu ];
+   PthCnt = &PthHed[ 2 * par->NmbCpu ];
+
+   // Each WP's list of bits is sized after its number of dependencies
+   arg.WrkBitOff[0] = 0;
+
+   for(w=0;w<NmbWrk;w++)
+      arg.WrkBitOff[ w+1 ] = arg.WrkBitOff[w] + typ->SmlWrkTab[w].NmbDep;
+
+   if(!(arg.WrkBitTab = LPL_malloc(par->lmb, (arg.WrkBitOff[ NmbWrk ] + 1) * sizeof(int))))
+      goto GrpEnd;
+
+   // The groups may be set in the middle of a user's launch
+   // whose procedure's arguments must not apply to this one
+   NmbVarArg = par->NmbVarArg;
+   PrcWid = par->PrcWid;
+   par->NmbVarArg = 0;
+   par->PrcWid = LplLng;
+   par->arg = &arg;
+   par->prc = SetWrkBit;
+   TemLch(par, NULL, 1, NmbWrk, par->NmbCpu, 1);
+   par->NmbVarArg = NmbVarArg;
+   par->PrcWid = PrcWid;
+
+   // Each thread owns a queue of consecutive WP and fills its part of each
+   // group with the first WP of its queue whose bits no other thread uses in
+   // this group, a thread whose queue is empty steals from the tail of the
+   // longest one, so that only the WP lying on the queues' borders are delayed
+   for(t=0;t<par->NmbCpu;t++)
+   {
+      PthHed[t] = (int)((int64_t)t * NmbWrk / par->NmbCpu);
+      PthTal[t] = (int)((int64_t)(t+1) * NmbWrk / par->NmbCpu) - 1;
+      PthCnt[t] = PthTal[t] - PthHed[t] + 1;
+
+      if(!PthCnt[t])
+         PthHed[t] = PthTal[t] = -1;
+
+      for(w=PthHed[t]; w>=0 && w<=PthTal[t]; w++)
+      {
+         WrkPrv[w] = (w > PthHed[t]) ? w - 1 : -1;
+         WrkNex[w] = (w < PthTal[t]) ? w + 1 : -1;
+      }
+   }
+
+   for(i=0;i<NmbBit;i++)
+      BitGrp[i] = -1;
+
+   LstGrp = NULL;
+
+   for(g=0, NmbDon=0; NmbDon<NmbWrk; g++)
+   {
+      if(!(grp = NewGrp(par)))
+         goto GrpEnd;
+
+      grp->idx = g + 1;
+
+      if(LstGrp)
+         LstGrp->nex = grp;
+      else
+         typ->NexGrp = grp;
+
+      LstGrp = grp;
+
+      for(t=0;t<par->NmbCpu;t++)
+      {
+         // Pick the own queue or the longest one
+         if(PthCnt[t])
+            u = t;
+         else
+            for(u=0, j=1; j<par->NmbCpu; j++)
+               if(PthCnt[j] > PthCnt[u])
+                  u = j;
+
+         w = (u == t) ? PthHed[u] : PthTal[u];
+
+         for(j=0; (w >= 0) && (j < GrpScnWin) && (grp->NmbSmlWrk[t] < WrkPerGrp); j++)
+         {
+            v = (u == t) ? WrkNex[w] : WrkPrv[w];
+
+            for(i=arg.WrkBitOff[w]; i<arg.WrkBitOff[ w+1 ]; i++)
+               if( (BitGrp[ arg.WrkBitTab[i] ] == g) && (BitPth[ arg.WrkBitTab[i] ] != t) )
+                  break;
+
+            if(i == arg.WrkBitOff[ w+1 ])
+            {
+               // Unlink the WP from its queue and add it to the thread's part
+               if(WrkPrv[w] >= 0)
+                  WrkNex[ WrkPrv[w] ] = WrkNex[w];
+               else
+                  PthHed[u] = WrkNex[w];
+
+               if(WrkNex[w] >= 0)
+                  WrkPrv[ WrkNex[w] ] = WrkPrv[w];
+               else
+                  PthTal[u] = WrkPrv[w];
+
+               PthCnt[u]--;
+
+               for(i=arg.WrkBitOff[w]; i<arg.WrkBitOff[ w+1 ]; i++)
+               {
+                  BitGrp[ arg.WrkBitTab[i] ] = g;
+                  BitPth[ arg.WrkBitTab[i] ] = t;
+               }
+
+               grp->SmlWrkTab[t][ grp->NmbSmlWrk[t]++ ] = &typ->SmlWrkTab[w];
+               NmbDon++;
+            }
+
+            w = v;
+         }
+      }
+   }
+
+   typ->NmbGrp = g;
+   res = SetGrpWai(par, typ);
+
+   GrpEnd:
+
+   if(arg.WrkBitOff)
+      LPL_free(par->lmb, arg.WrkBitOff);
+
+   if(arg.WrkBitTab)
+      LPL_free(par->lmb, arg.WrkBitTab);
+
+   if(BitGrp)
+      LPL_free(par->lmb, BitGrp);
+
+   if(BitPth)
+      LPL_free(par->lmb, BitPth);
+
+   if(WrkNex)
+      LPL_free(par->lmb, WrkNex);
+
+   if(WrkPrv)
+      LPL_free(par->lmb, WrkPrv);
+
+   if(PthHed)
+      LPL_free(par->lmb, PthHed);
+
+   // Groups built before a failure are not kept, even partially
+   if(!res)
+      FreGrp(par, typ);
+
+   return(res);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* List the dependency bits of a range of WP                                  */
+/*----------------------------------------------------------------------------*/
+
+static void SetWrkBit(itg BegIdx, itg EndIdx, int PthIdx, void *ptr)
+{
+   int         j, k, w, idx;
+   GrpArgSct   *arg = (GrpArgSct *)ptr;
+   WrkSct      *wrk;
+   (void)(PthIdx);
+
+   for(w=(int)BegIdx-1; w<EndIdx; w++)
+   {
+      wrk = &arg->typ->SmlWrkTab[w];
+      idx = arg->WrkBitOff[w];
+
+      for(j=0;j<arg->typ->NmbDepWrd;j++)
+         if(wrk->DepWrdTab[j])
+            for(k=0;k<32;k++)
+               if(GetBit(wrk->DepWrdTab, j * 32 + k) && (idx < arg->WrkBitOff[ w+1 ]))
+                  arg->WrkBitTab[ idx++ ] = j * 32 + k;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate WP along with their interleaved ranges, stored in a single table  */
+/*----------------------------------------------------------------------------*/
+
+static BigSct *NewItlWrk(ParSct *par, int NmbWrk)
+{
+   int      i;
+   itg      (*ItlMat)[2];
+   BigSct   *WrkTab;
+
+   if(!(WrkTab = LPL_calloc(par->lmb, NmbWrk, sizeof(BigSct))))
+      return(NULL);
+
+   if(!(ItlMat = LPL_calloc(par->lmb, (int64_t)NmbWrk * MaxItlBlk, 2 * sizeof(itg))))
+   {
+      LPL_free(par->lmb, WrkTab);
+      return(NULL);
+   }
+
+   for(i=0;i<NmbWrk;i++)
+      WrkTab[i].ItlTab = &ItlMat[ i * MaxItlBlk ];
+
+   return(WrkTab);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free WP allocated with their interleaved ranges                            */
+/*----------------------------------------------------------------------------*/
+
+static void FreItlWrk(ParSct *par, BigSct *WrkTab)
+{
+   LPL_free(par->lmb, WrkTab[0].ItlTab);
+   LPL_free(par->lmb, WrkTab);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate a static group along with its threads' tables                     */
+/*----------------------------------------------------------------------------*/
+
+static GrpSct *NewGrp(ParSct *par)
+{
+   GrpSct *grp;
+
+   if(!(grp = GetBlk(par, &par->GrpArn)))
+      return(NULL);
+
+   grp->SmlWrkTab = (WrkSct *(*)[ WrkPerGrp ])&grp[1];
+   grp->NmbSmlWrk = (int *)&grp->SmlWrkTab[ par->NmbCpu ];
+
+   return(grp);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Wake up the first NmbPth threads and wait for their completion, large      */
+/* teams are woken and gathered along a tree of threads instead of one by one */
+/* by the scheduler, called with ParMtx locked                                */
+/*----------------------------------------------------------------------------*/
+
+static void RunTre(ParSct *par, int NmbPth)
+{
+   int      i;
+   PthSct   *pth;
+
+   par->WrkCpt = 0;
+   par->NmbWak = NmbPth;
+   par->TreWak = (NmbPth > TreWakPth);
+
+   // With a tree, only the root is woken and it passes the signal along
+   for(i=0; i < (par->TreWak ? 1 : NmbPth); i++)
+   {
+      pth = &par->PthTab[i];
+      pthread_mutex_lock(&pth->mtx);
+      pthread_cond_signal(&pth->cnd);
+      pthread_mutex_unlock(&pth->mtx);
+   }
+
+   while(par->WrkCpt < NmbPth)
+      pthread_cond_wait(&par->ParCnd, &par->ParMtx);
+
+   par->TreWak = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Wake up a thread's sons in the tree, called with the thread's mutex locked */
+/*----------------------------------------------------------------------------*/
+
+static void WakSon(ParSct *par, PthSct *pth)
+{
+   int      i, SonTab[ 2 * WakTreFan ];
+   PthSct   *son;
+
+   pth->NmbSon = GetSon(par, pth->idx, SonTab);
+   pth->SonDon = 0;
+
+   for(i=0;i<pth->NmbSon;i++)
+   {
+      son = &par->PthTab[ SonTab[i] ];
+      pthread_mutex_lock(&son->mtx);
+      pthread_cond_signal(&son->cnd);
+      pthread_mutex_unlock(&son->mtx);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Report a thread's completion: to the scheduler when woken by it or, along  */
+/* the tree, once all its sons have reported the completion of their own      */
+/* sub-trees, the root telling the scheduler that the whole team is done      */
+/*----------------------------------------------------------------------------*/
+
+static void EndTre(ParSct *par, PthSct *pth)
+{
+   PthSct *fat;
+
+   if(!par->TreWak)
+   {
+      pthread_mutex_lock(&par->ParMtx);
+
+      if(++par->WrkCpt >= par->NmbWak)
+         pthread_cond_signal(&par->ParCnd);
+
+      pthread_mutex_unlock(&par->ParMtx);
+      return;
+   }
+
+   // The sons lock this thread's mutex to report, which is only
+   // released while waiting
+   while(pth->SonDon < pth->NmbSon)
+      pthread_cond_wait(&pth->cnd, &pth->mtx);
+
+   if(pth->idx)
+   {
+      fat = &par->PthTab[ GetFat(par, pth->idx) ];
+      pthread_mutex_lock(&fat->mtx);
+      fat->SonDon++;
+      pthread_cond_signal(&fat->cnd);
+      pthread_mutex_unlock(&fat->mtx);
+   }
+   else
+   {
+      pthread_mutex_lock(&par->ParMtx);
+      par->WrkCpt = par->NmbWak;
+      pthread_cond_signal(&par->ParCnd);
+      pthread_mutex_unlock(&par->ParMtx);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Threads are gathered by last level cache: the leader of each group wakes   */
+/* the leaders of WakTreFan other groups first, then every thread wakes       */
+/* WakTreFan threads of its own group, so that a launch takes a logarithmic   */
+/* number of steps, return the number of sons among the woken threads         */
+/*----------------------------------------------------------------------------*/
+
+static int GetSon(ParSct *par, int PthIdx, int *SonTab)
+{
+   int k, idx, NmbSon = 0, GrpSiz = par->LlcPth;
+   int LedIdx = PthIdx / GrpSiz, off = PthIdx % GrpSiz, BegIdx = PthIdx - off;
+
+   if(!off)
+      for(k=1;k<=WakTreFan;k++)
+      {
+         idx = (LedIdx * WakTreFan + k) * GrpSiz;
+
+         if(idx < par->NmbWak)
+            SonTab[ NmbSon++ ] = idx;
+      }
+
+   for(k=1;k<=WakTreFan;k++)
+   {
+      idx = off * WakTreFan + k;
+
+      if( (idx < GrpSiz) && (BegIdx + idx < par->NmbWak) )
+         SonTab[ NmbSon++ ] = BegIdx + idx;
+   }
+
+   return(NmbSon);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Return the thread that wakes this one up in the tree                       */
+/*----------------------------------------------------------------------------*/
+
+static int GetFat(ParSct *par, int PthIdx)
+{
+   int GrpSiz = par->LlcPth, off = PthIdx % GrpSiz;
+
+   if(off)
+      return(PthIdx - off + (off - 1) / WakTreFan);
+
+   return(((PthIdx / GrpSiz - 1) / WakTreFan) * GrpSiz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate a cleared memory area starting on a cache line, the address of    */
+/* the underlying allocation is stored just before the aligned one            */
+/*----------------------------------------------------------------------------*/
+
+static void *AlcAln(void *lmb, int64_t siz)
+{
+   char *BasAdr, *AlnAdr;
+
+   if(!(BasAdr = LPL_calloc(lmb, 1, siz + CchLinSiz + sizeof(void *))))
+      return(NULL);
+
+   AlnAdr = (char *)(((size_t)BasAdr + sizeof(void *) + CchLinSiz - 1)
+                     & ~((size_t)CchLinSiz - 1));
+
+   ((void **)AlnAdr)[-1] = BasAdr;
+
+   return(AlnAdr);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free a memory area allocated by AlcAln                                     */
+/*----------------------------------------------------------------------------*/
+
+static void FreAln(void *lmb, void *adr)
+{
+   LPL_free(lmb, ((void **)adr)[-1]);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set an arena of fixed size blocks, each one being preceded by its header   */
+/* and rounded up to whole cache lines                                        */
+/*----------------------------------------------------------------------------*/
+
+static void IniArn(ArnSct *arn, size_t BlkSiz, int ClrFlg)
+{
+   pthread_mutex_init(&arn->mtx, NULL);
+   arn->BlkSiz = ((BlkSiz + CchLinSiz - 1) / CchLinSiz + 1) * CchLinSiz;
+   arn->BlkPerChk = MAX(1, (ArnChkSiz - CchLinSiz) / arn->BlkSiz);
+   arn->ClrFlg = ClrFlg;
+   arn->AlcSiz = 0;
+   arn->FreBlk = NULL;
+   arn->NexChk = NULL;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Get a block from the arena's free list or from a new chunk, instead of     */
+/* going through the system's allocator shared by all threads                 */
+/*----------------------------------------------------------------------------*/
+
+static void *GetBlk(ParSct *par, ArnSct *arn)
+{
+   int      i;
+   char     *chk;
+   BlkSct   *blk;
+
+   pthread_mutex_lock(&arn->mtx);
+
+   if(!arn->FreBlk)
+   {
+      // The chunks are linked through their first cache line
+      if(!(chk = AlcAln(par->lmb, CchLinSiz + arn->BlkPerChk * arn->BlkSiz)))
+      {
+         pthread_mutex_unlock(&arn->mtx);
+         return(NULL);
+      }
+
+      *(void **)chk = arn->NexChk;
+      arn->NexChk = chk;
+      arn->AlcSiz += CchLinSiz + arn->BlkPerChk * arn->BlkSiz;
+
+      for(i=0;i<arn->BlkPerChk;i++)
+      {
+         blk = (BlkSct *)&chk[ CchLinSiz + i * arn->BlkSiz ];
+         blk->nex = arn->FreBlk;
+         arn->FreBlk = blk;
+      }
+   }
+
+   blk = arn->FreBlk;
+   arn->FreBlk = blk->nex;
+   pthread_mutex_unlock(&arn->mtx);
+
+   // Wait for the end of the pipe thread that last ran on this stack
+   if(blk->JoiFlg)
+   {
+      pthread_join(blk->pth, NULL);
+      blk->JoiFlg = 0;
+   }
+
+   if(arn->ClrFlg)
+      memset((char *)blk + CchLinSiz, 0, arn->BlkSiz - CchLinSiz);
+
+   return((char *)blk + CchLinSiz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Give a block back to its arena, with JoiFlg set the calling thread is      */
+/* to be joined before the block is reused                                    */
+/*----------------------------------------------------------------------------*/
+
+static void PutBlk(ArnSct *arn, void *adr, int JoiFlg)
+{
+   BlkSct *blk = (BlkSct *)((char *)adr - CchLinSiz);
+
+   if(JoiFlg)
+      blk->pth = pthread_self();
+
+   pthread_mutex_lock(&arn->mtx);
+   blk->JoiFlg = JoiFlg;
+   blk->nex = arn->FreBlk;
+   arn->FreBlk = blk;
+   pthread_mutex_unlock(&arn->mtx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Join the threads still attached to free blocks and free the arena's chunks */
+/*----------------------------------------------------------------------------*/
+
+static void FreArn(ParSct *par, ArnSct *arn)
+{
+   void     *chk;
+   BlkSct   *blk;
+
+   for(blk = arn->FreBlk; blk; blk = blk->nex)
+      if(blk->JoiFlg)
+      {
+         pthread_join(blk->pth, NULL);
+         blk->JoiFlg = 0;
+      }
+
+   while((chk = arn->NexChk))
+   {
+      arn->NexChk = *(void **)chk;
+      FreAln(par->lmb, chk);
+   }
+
+   arn->FreBlk = NULL;
+   pthread_mutex_destroy(&arn->mtx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sum the threads' wake-up stats into the average concurrency factor         */
+/*----------------------------------------------------------------------------*/
+
+static float SumSta(ParSct *par)
+{
+   int   i;
+   float NmbWak = 0., NmbRun = 0.;
+
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      NmbWak += par->PthTab[i].sta[0];
+      NmbRun += par->PthTab[i].sta[1];
+   }
+
+   return(NmbWak ? (NmbRun / NmbWak) : 0.);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Tell whether a memory operation is worth waking up the threads: when the   */
+/* time one thread would take at the measured bandwidth exceeds twice the     */
+/* wake-up cost, or above a large size as long as nothing was measured        */
+/*----------------------------------------------------------------------------*/
+
+static int ParMem(ParSct *par, int cpy, size_t siz)
+{
+   if(par->NmbCpu == 1)
+      return(0);
+
+   if(par->MemBwd[ cpy ] > 0.)
+      return(siz > 2. * par->WakTim * par->MemBwd[ cpy ]);
+
+   return(siz >= BigMemSiz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Keep the best bandwidth of the sequential runs long enough to be timed     */
+/*----------------------------------------------------------------------------*/
+
+static void SetMemBwd(ParSct *par, int cpy, size_t siz, double tim)
+{
+   if( (siz >= MinBwdSiz) && (tim > 0.) )
+      par->MemBwd[ cpy ] = MAX(par->MemBwd[ cpy ], siz / tim);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Offset of a thread's part of a buffer, the even split is moved down to a   */
+/* page boundary so that each page is always handled by the same thread, and  */
+/* down to a multiple of GrnSiz bytes from the beginning of the buffer        */
+/*----------------------------------------------------------------------------*/
+
+static size_t SlcOff(ParSct *par, char *adr, size_t siz, size_t GrnSiz, int idx)
+{
+   size_t off, PagOff;
+
+   if(idx <= 0)
+      return(0);
+
+   if(idx >= par->NmbCpu)
+      return(siz);
+
+   off = siz / par->NmbCpu * idx;
+   PagOff = ((size_t)adr + off) % RegPagSiz;
+   off = (off > PagOff) ? off - PagOff : 0;
+
+   return(off - off % GrnSiz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Clear a memory area, with non-temporal stores if str is set, so that a     */
+/* buffer bigger than the last level cache is written without being read      */
+/*----------------------------------------------------------------------------*/
+
+static void ClrKer(char *adr, size_t siz, int str)
+{
+#ifdef __SSE2__
+   size_t   HedSiz;
+   __m128i  zer = _mm_setzero_si128();
+
+   if(str && (siz >= 2 * sizeof(__m128i)))
+   {
+      HedSiz = (sizeof(__m128i) - (size_t)adr % sizeof(__m128i)) % sizeof(__m128i);
+      memset(adr, 0, HedSiz);
+
+      for(adr += HedSiz, siz -= HedSiz; siz >= sizeof(__m128i);
+          adr += sizeof(__m128i), siz -= sizeof(__m128i))
+      {
+         _mm_stream_si128((__m128i *)adr, zer);
+      }
+
+      _mm_sfence();
+   }
+#else
+   (void)str;
+#endif
+
+   memset(adr, 0, siz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Copy a memory area, with non-temporal stores if str is set                 */
+/*----------------------------------------------------------------------------*/
+
+static void CpyKer(char *dst, char *src, size_t siz, int str)
+{
+#ifdef __SSE2__
+   size_t   HedSiz;
+
+   if(str && (siz >= 2 * sizeof(__m128i)))
+   {
+      HedSiz = (sizeof(__m128i) - (size_t)dst % sizeof(__m128i)) % sizeof(__m128i);
+      memcpy(dst, src, HedSiz);
+
+      // Write whole cache lines to fill the write-combining buffers
+      for(dst += HedSiz, src += HedSiz, siz -= HedSiz; siz >= 4 * sizeof(__m128i);
+          dst += 4 * sizeof(__m128i), src += 4 * sizeof(__m128i), siz -= 4 * sizeof(__m128i))
+      {
+         _mm_stream_si128((__m128i *)dst,     _mm_loadu_si128((__m128i *)src));
+         _mm_stream_si128((__m128i *)dst + 1, _mm_loadu_si128((__m128i *)src + 1));
+         _mm_stream_si128((__m128i *)dst + 2, _mm_loadu_si128((__m128i *)src + 2));
+         _mm_stream_si128((__m128i *)dst + 3, _mm_loadu_si128((__m128i *)src + 3));
+      }
+
+      _mm_sfence();
+   }
+#else
+   (void)str;
+#endif
+
+   memcpy(dst, src, siz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Fill a memory area with copies of a pattern: the pattern is doubled up to  */
+/* a block that stays in the L1 cache, which is then copied along the area    */
+/*----------------------------------------------------------------------------*/
+
+static void SetKer(char *dst, size_t siz, char *pat, size_t PatSiz, int str)
+{
+   size_t BlkSiz, len, off;
+
+   if(!siz)
+      return;
+
+   BlkSiz = MIN(siz, MAX(PatSiz, PatBlkSiz / PatSiz * PatSiz));
+   off = MIN(PatSiz, BlkSiz);
+   memcpy(dst, pat, off);
+
+   while(off < BlkSiz)
+   {
+      len = MIN(off, BlkSiz - off);
+      memcpy(&dst[ off ], dst, len);
+      off += len;
+   }
+
+   for(off = BlkSiz; off < siz; off += BlkSiz)
+      CpyKer(&dst[ off ], dst, MIN(BlkSiz, siz - off), str);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free a type's static groups                                                */
+/*----------------------------------------------------------------------------*/
+
+static void FreGrp(ParSct *par, TypSct *typ)
+{
+   GrpSct *grp, *NexGrp = typ->NexGrp;
+
+   while((grp = NexGrp))
+   {
+      NexGrp = grp->nex;
+
+      if(grp->WaiTab)
+         LPL_free(par->lmb, grp->WaiTab);
+
+      PutBlk(&par->GrpArn, grp, 0);
+   }
+
+   typ->NexGrp = NULL;
+   typ->NmbGrp = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* For each group and thread, get the last former group each other thread     */
+/* must have completed before this part may run                               */
+/*----------------------------------------------------------------------------*/
+
+static int SetGrpWai(ParSct *par, TypSct *typ)
+{
+   int      i, j, k, b, GrpIdx, siz = typ->NmbDepWrd, res = 0;
+   int      *PrtWrd, *LstGrp, *LstPth;
+   GrpSct   *grp;
+
+   // Allocate the words of the threads' parts and the last group
+   // and thread that used each dependency bit
+   PrtWrd = LPL_malloc(par->lmb, par->NmbCpu * siz * sizeof(int));
+   LstGrp = LPL_calloc(par->lmb, siz * 32, sizeof(int));
+   LstPth = LPL_calloc(par->lmb, siz * 32, sizeof(int));
+
+   if(!PrtWrd || !LstGrp || !LstPth)
+      goto WaiEnd;
+
+   for(grp = typ->NexGrp, GrpIdx = 1; grp; grp = grp->nex, GrpIdx++)
+   {
+      if(!(grp->WaiTab = LPL_calloc(par->lmb, par->NmbCpu * par->NmbCpu, sizeof(int))))
+         goto WaiEnd;
+
+      memset(PrtWrd, 0, par->NmbCpu * siz * sizeof(int));
+
+      for(i=0;i<par->NmbCpu;i++)
+         for(j=0;j<grp->NmbSmlWrk[i];j++)
+            AddWrd(siz, grp->SmlWrkTab[i][j]->DepWrdTab, &PrtWrd[ i * siz ]);
+
+      // Parts of a group being disjoint, only the last former part using a
+      // bit must be waited for: it waited itself for the previous ones
+      for(i=0;i<par->NmbCpu;i++)
+         for(j=0;j<siz;j++)
+            if(PrtWrd[ i * siz + j ])
+               for(k=0;k<32;k++)
+               {
+                  b = j * 32 + k;
+
+                  if(!GetBit(&PrtWrd[ i * siz ], b) || !LstGrp[b] || (LstPth[b] == i))
+                     continue;
+
+                  grp->WaiTab[ i * par->NmbCpu + LstPth[b] ] =
+                     MAX(grp->WaiTab[ i * par->NmbCpu + LstPth[b] ], LstGrp[b]);
+               }
+
+      for(i=0;i<par->NmbCpu;i++)
+         for(j=0;j<siz;j++)
+            if(PrtWrd[ i * siz + j ])
+               for(k=0;k<32;k++)
+                  if(GetBit(&PrtWrd[ i * siz ], j * 32 + k))
+                  {
+                     LstGrp[ j * 32 + k ] = GrpIdx;
+                     LstPth[ j * 32 + k ] = i;
+                  }
+   }
+
+   // The groups are up to date with the dependencies
+   typ->OrdUpd = 0;
+   UpdMem(par, (int)(typ - par->TypTab));
+   res = 1;
+
+   // The groups' wait tables already set are released along with the groups
+   WaiEnd:
+
+   if(PrtWrd)
+      LPL_free(par->lmb, PrtWrd);
+
+   if(LstGrp)
+      LPL_free(par->lmb, LstGrp);
+
+   if(LstPth)
+      LPL_free(par->lmb, LstPth);
+
+   return(res);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Launch a colorgrain parallel procudure taking 32 bit indices and variable  */
+/* arguments. Arguments are passed as pointer to void.                        */
+/*----------------------------------------------------------------------------*/
+
+float LaunchColorGrainsMultiArg32( int64_t ParIdx, int typ,
+                                   void *prc, int NmbArg, ... )
+{
+   float acc;
+   va_list ArgLst;
+
+   va_start(ArgLst, NmbArg);
+   acc = GrnVar((ParSct *)ParIdx, LplInt, typ, prc, NmbArg, ArgLst);
+   va_end(ArgLst);
+
+   return(acc);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Launch a colorgrain parallel procudure taking 64 bit indices and variable  */
+/* arguments. Arguments are passed as pointer to void.                        */
+/*----------------------------------------------------------------------------*/
+
+float LaunchColorGrainsMultiArg64( int64_t ParIdx, int typ,
+                                   void *prc, int NmbArg, ... )
+{
+   float acc;
+   va_list ArgLst;
+
+   va_start(ArgLst, NmbArg);
+   acc = GrnVar((ParSct *)ParIdx, LplLng, typ, prc, NmbArg, ArgLst);
+   va_end(ArgLst);
+
+   return(acc);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Store the variable arguments and launch the colorgrain procedure           */
+/*----------------------------------------------------------------------------*/
+
+static float GrnVar( ParSct *par, int wid, int typ, void *prc,
+                     int NmbArg, va_list ArgLst )
+{
+   int i;
+   float acc;
+
+   if(!par || (NmbArg > 20))
+      return(-1.);
+
+   par->NmbVarArg = NmbArg;
+
+   for(i=0;i<NmbArg;i++)
+      par->VarArgTab[i] = va_arg(ArgLst, void *);
+
+   acc = LchGrn(par, wid, typ, prc, NULL);
+   par->NmbVarArg = 0;
+
+   return(acc);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Launch the colorgrain loop prc taking 32 bit indices on typ                */
+/*----------------------------------------------------------------------------*/
+
+float LaunchColorGrains32(int64_t ParIdx, int typ, void *prc, void *PtrArg)
+{
+   return(LchGrn((ParSct *)ParIdx, LplInt, typ, prc, PtrArg));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Launch the colorgrain loop prc taking 64 bit indices on typ                */
+/*----------------------------------------------------------------------------*/
+
+float LaunchColorGrains64(int64_t ParIdx, int typ, void *prc, void *PtrArg)
+{
+   return(LchGrn((ParSct *)ParIdx, LplLng, typ, prc, PtrArg));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Launch the loop prc on typ1 element depending on typ2                      */
+/*----------------------------------------------------------------------------*/
+
+static float LchGrn(ParSct *par, int wid, int typ, void *prc, void *PtrArg)
+{
+   int      i;
+   float    acc = 0.;
+   PthSct   *pth;
+
+   // Get and check lib parallel instance
+   if(!par)
+      return(-1.);
+
+   // The procedure is called with the indices' width it was launched with
+   par->PrcWid = wid;
+
+   if(par->CapGrf)
+      AddCap(par, RunGrnWrk, typ, 0, prc, PtrArg, NULL, 0);
+
+   // Lock acces to global parameters
+   pthread_mutex_lock(&par->ParMtx);
+
+   par->cmd = RunGrnWrk;
+   par->prc = (void (*)(itg, itg, int, void *))prc;
+   par->arg = PtrArg;
+   par->typ1 = NULL;
+   par->typ2 = NULL;
+   par->NexWrk = par->GrnWrkTab;
+   par->WrkCpt = 0;
+   par->req = 0;
+   par->NmbDep = 0;
+   par->CurCol = 1;
+
+   // Clear running wp and stats
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      par->PthTab[i].wrk = NULL;
+      par->PthTab[i].sta[0] = par->PthTab[i].sta[1] = 0.;
+   }
+
+   ClrWrd(par->NmbGrnWrd, par->RunGrnTab);
+
+   // Build a linked list of wp
+   for(i=0;i<par->NmbGrnWrk;i++)
+   {
+      par->GrnWrkTab[i].pre = &par->GrnWrkTab[ i-1 ];
+      par->GrnWrkTab[i].nex = &par->GrnWrkTab[ i+1 ];
+      par->GrnWrkTab[i].BegIdx = par->GrnTab[ typ ][i+1][0];
+      par->GrnWrkTab[i].EndIdx = par->GrnTab[ typ ][i+1][1];
+   }
+
+   par->GrnWrkTab[0].pre = par->GrnWrkTab[ par->NmbGrnWrk - 1 ].nex = NULL;
+
+   for(i=1;i<=par->NmbCol;i++)
+      par->ColCpt[i] = par->ColTab[i][1] - par->ColTab[i][0] + 1;
+
+
+   // Main loop: wake up threads and wait for completion or blocked threads
+   do
+   {
+      // Search for some idle threads
+      par->req = 0;
+
+      for(i=0;i<par->NmbCpu;i++)
+      {
+         pth = &par->PthTab[i];
+
+         if(pth->wrk)
+            continue;
+
+         if(!(pth->wrk = NexGrn(par, i)))
+         {
+            par->req = 1;
+            break;
+         }
+
+         // Wake up the thread and provide it with a WP list
+         pthread_mutex_lock(&pth->mtx);
+         pthread_cond_signal(&pth->cnd);
+         pthread_mutex_unlock(&pth->mtx);
+      }
+
+      // If every WP are done : exit the parallel loop
+      if(par->WrkCpt == par->NmbGrnWrk)
+         break;
+
+      // Otherwise, wait for a blocked thread
+      pthread_cond_wait(&par->ParCnd, &par->ParMtx);
+   }while(1);
+
+   pthread_mutex_unlock(&par->ParMtx);
+
+   // Compute the average concurrency factor
+   acc = SumSta(par);
+
+   // Clear the main datatyp loop to indicate that no LaunchParallel is running
+   par->typ1 = 0;
+   par->PrcWid = LplLng;
+
+   // Return the concurrency factor
+   return(acc);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Tell the pthread handler to clear a chunmk of memory in parallel           */
+/*----------------------------------------------------------------------------*/
+
+int ParallelMemClear(int64_t ParIdx, void *PtrArg, size_t siz)
+{
+   int      i;
+   size_t   off;
+   double   tim;
+   PthSct   *pth;
+   ParSct   *par = (ParSct *)ParIdx;
+   char     *tab = (char *)PtrArg;
+
+   // Get and check lib parallel instance, adresse and size
+   if(!ParIdx || !tab)
+      return(0);
+
+   if(par->CapGrf)
+      AddCap(par, ClrMem, 0, 0, NULL, NULL, tab, siz);
+
+   // If the memory chunk is too small, clear it sequentially
+   if(!ParMem(par, 0, siz))
+   {
+      tim = GetWallClock();
+      ClrKer(tab, siz, siz > par->LlcSiz);
+      SetMemBwd(par, 0, siz, GetWallClock() - tim);
+      return(1);
+   }
+
+   // Lock acces to global parameters
+   pthread_mutex_lock(&par->ParMtx);
+
+   par->cmd = ClrMem;
+   par->WrkCpt = 0;
+   par->MemStr = siz > par->LlcSiz;
+
+   // Spread the buffer's pages among the threads
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      pth = &par->PthTab[i];
+      off = SlcOff(par, tab, siz, 1, i);
+      pth->ClrAdr = &tab[ off ];
+      pth->ClrMemSiz = SlcOff(par, tab, siz, 1, i+1) - off;
+   }
+
+   // Wake them up and wait for each thread to complete
+   RunTre(par, par->NmbCpu);
+
+   pthread_mutex_unlock(&par->ParMtx);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Tell the pthread handler to copy a chunmk of memory in parallel            */
+/*----------------------------------------------------------------------------*/
+
+int ParallelMemCopy(int64_t ParIdx, void *PtrDst, void *PtrSrc, size_t siz)
+{
+   int      i;
+   PthSct   *pth;
+   ParSct   *par = (ParSct *)ParIdx;
+   size_t   off;
+   double   tim;
+   char     *DstTab = (char *)PtrDst;
+   char     *SrcTab = (char *)PtrSrc;
+
+   // Get and check lib parallel instance, adresse and size
+   if(!ParIdx || !PtrDst || !PtrSrc)
+      return(0);
+
+   // If the memory chunk is too small, copy it sequentially
+   if(!ParMem(par, 1, siz))
+   {
+      // The libc already streams the stores of a large enough copy
+      tim = GetWallClock();
+      CpyKer(DstTab, SrcTab, siz, 0);
+      SetMemBwd(par, 1, siz, GetWallClock() - tim);
+      return(1);
+   }
+
+   // Lock acces to global parameters
+   pthread_mutex_lock(&par->ParMtx);
+
+   par->cmd = CpyMem;
+   par->WrkCpt = 0;
+   par->MemStr = siz > par->LlcSiz;
 
-   // For each new block, compute the logical OR between two consecutive old blocks
-   // The new data is copied on top of former one
-   for(i=0;i<typ1->NmbSmlWrk;i+=2)
+   // Spread the destination buffer's pages among the threads
+   for(i=0;i<par->NmbCpu;i++)
    {
-      EvnWrk = &typ1->SmlWrkTab[ i     ];
-      OddWrk = &typ1->SmlWrkTab[ i + 1 ];
-      NewWrk = &typ1->SmlWrkTab[ i / 2 ];
-      NewWrk->BegIdx = EvnWrk->BegIdx;
-      NewWrk->EndIdx = OddWrk->EndIdx;
-
-      for(j=0;j<typ1->NmbDepWrd;j++)
-         if(i+1 < typ1->NmbSmlWrk)
-            NewWrk->DepWrdTab[j] = EvnWrk->DepWrdTab[j] | OddWrk->DepWrdTab[j];
-         else
-            NewWrk->DepWrdTab[j] = EvnWrk->DepWrdTab[j];
+      pth = &par->PthTab[i];
+      off = SlcOff(par, DstTab, siz, 1, i);
+      pth->DstAdr = &DstTab[ off ];
+      pth->SrcAdr = &SrcTab[ off ];
+      pth->CpyMemSiz = SlcOff(par, DstTab, siz, 1, i+1) - off;
    }
 
-   // Halve the number of blocks and add one if the number was odd
-   typ1->SmlWrkSiz *= typ1->NmbSmlWrk;
-
-   if(typ1->NmbSmlWrk & 1)
-      typ1->NmbSmlWrk = typ1->NmbSmlWrk / 2 + 1;
-   else
-      typ1->NmbSmlWrk /= 2;
+   // Wake them up and wait for each thread to complete
+   RunTre(par, par->NmbCpu);
 
-   typ1->SmlWrkSiz /= typ1->NmbSmlWrk;
+   pthread_mutex_unlock(&par->ParMtx);
 
-   return(typ1->NmbSmlWrk);
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Halve the number of dependency words by ORing consecutive pairs of bits    */
+/* Fill a chunk of memory in parallel with copies of a pattern of any size    */
 /*----------------------------------------------------------------------------*/
 
-int HalveDependencyBlocks(int64_t ParIdx, int TypIdx1, int TypIdx2)
+int ParallelMemSet(int64_t ParIdx, void *PtrArg, size_t siz, void *PatAdr, size_t PatSiz)
 {
-   int i, j;
-   WrkSct *wrk;
-   ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ1, *typ2;
+   int      i;
+   size_t   off;
+   double   tim;
+   PthSct   *pth;
+   ParSct   *par = (ParSct *)ParIdx;
+   char     *tab = (char *)PtrArg;
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
+   // Get and check lib parallel instance, adresses and sizes
+   if(!ParIdx || !tab || !PatAdr || !PatSiz)
       return(0);
 
-   // Check bounds
-   typ1 = &par->TypTab[ TypIdx1 ];
-   typ2 = &par->TypTab[ TypIdx2 ];
-
-   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
-   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
-   ||  !typ2->NmbLin )
+   // Filling costs about as much as clearing
+   if(!ParMem(par, 0, siz))
    {
-      return(0);
+      tim = GetWallClock();
+      SetKer(tab, siz, (char *)PatAdr, PatSiz, siz > par->LlcSiz);
+      SetMemBwd(par, 0, siz, GetWallClock() - tim);
+      return(1);
    }
 
-   // Do not halve the number of blocks if there is only one left
-   if(typ1->NmbDepWrd < 2)
-      return(0);
+   // Lock acces to global parameters
+   pthread_mutex_lock(&par->ParMtx);
 
-   for(i=0;i<typ1->NmbSmlWrk;i++)
-   {
-      wrk = &typ1->SmlWrkTab[i];
+   par->cmd = SetMem;
+   par->WrkCpt = 0;
+   par->MemStr = siz > par->LlcSiz;
+   par->PatSiz = PatSiz;
 
-      for(j=0;j<typ1->NmbDepWrd;j+=2)
-         if(GetBit(wrk->DepWrdTab, j) || GetBit(wrk->DepWrdTab, j+1))
-            SetBit(wrk->DepWrdTab, j/2);
-         else
-            ClrBit(wrk->DepWrdTab, j/2);
+   // Each thread's part starts with a whole pattern
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      pth = &par->PthTab[i];
+      off = SlcOff(par, tab, siz, PatSiz, i);
+      pth->DstAdr = &tab[ off ];
+      pth->SrcAdr = (char *)PatAdr;
+      pth->CpyMemSiz = SlcOff(par, tab, siz, PatSiz, i+1) - off;
    }
 
-   typ1->DepWrkSiz *= typ1->NmbDepWrd;
-
-   if(typ1->NmbDepWrd & 1)
-      typ1->NmbDepWrd = typ1->NmbDepWrd / 2 + 1;
-   else
-      typ1->NmbDepWrd /= 2;
+   // Wake them up and wait for each thread to complete
+   RunTre(par, par->NmbCpu);
 
-   typ1->DepWrkSiz /= typ1->NmbDepWrd;
+   pthread_mutex_unlock(&par->ParMtx);
 
-   return(typ1->NmbDepWrd * 32);
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Return a block of elements' begin and ending indices                       */
+/* Allocate a table of bytes per entity for each line of a type, from 1 to    */
+/* NmbLin, and clear it in parallel so that the system places each page on    */
+/* the node of the thread that first touches it: the one that runs this part  */
+/* of the type in a loop without dependencies or, with LplInterleavedPages,   */
+/* each thread in turn for randomly accessed data                             */
 /*----------------------------------------------------------------------------*/
 
-int GetBigBlkNfo(int64_t ParIdx, int TypIdx, int BlkIdx, int *BegIdx, int *EndIdx)
+void *ParallelAlloc(int64_t ParIdx, int TypIdx, size_t EntSiz, int flg)
 {
-   ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ;
+   int      clk;
+   TchSct   tch;
+   TypSct   *typ;
+   ParSct   *par = (ParSct *)ParIdx;
 
-   // Get and check lib parallel instance, type and block indices
-   if(!ParIdx || TypIdx < 1 || TypIdx >= MaxTyp || BlkIdx < 0 || BlkIdx >= par->NmbCpu)
-      return(0);
+   // Get and check lib parallel instance and type
+   if(!ParIdx || (TypIdx < 1) || (TypIdx > MaxTyp) || !EntSiz || par->typ1)
+      return(NULL);
 
-   // Check if thi type has been allocated
    typ = &par->TypTab[ TypIdx ];
 
    if(!typ->NmbLin)
-      return(0);
+      return(NULL);
 
-   // Set begin and end indices
-   *BegIdx = typ->BigWrkTab[ BlkIdx ].ItlTab[0][0];
-   *EndIdx = typ->BigWrkTab[ BlkIdx ].ItlTab[0][1];
+   // The pages are cleared by their first touch
+   if(!(tch.adr = AlcHug(par->lmb, (int64_t)(typ->NmbLin + 1) * EntSiz,
+                         flg & ~LplClearMemory)))
+   {
+      return(NULL);
+   }
 
-   return(1);
+   tch.EntSiz = EntSiz;
+   memset(tch.adr, 0, EntSiz);
+
+   if(flg & LplInterleavedPages)
+   {
+      // Deal the pages out to the threads in a round robin way,
+      // each one being given its rank as a range of lines
+      tch.PagSiz = (((HugSct *)(tch.adr - CchLinSiz))->typ == HugMal)
+                 ? RegPagSiz : HugPagSiz;
+      tch.TotSiz = (typ->NmbLin + 1) * EntSiz;
+      tch.NmbPth = par->NmbCpu;
+      par->prc = TchPag;
+      par->arg = &tch;
+      TemLch(par, NULL, 1, par->NmbCpu, par->NmbCpu, 1);
+   }
+   else
+   {
+      // Clear the big WP the way a plain LaunchParallel runs them, without
+      // the timing of the blocks that would adapt them to this loop.
+      // The launch policy and the auto-tuner pick their team and
+      // interleaving per procedure, which is not known here, so the
+      // placement only matches loops they leave on the full pool
+      clk = par->clk;
+      par->clk = 0;
+      LchPar(par, TypIdx, 0, (void *)TchBlk, (void *)&tch);
+      par->clk = clk;
+   }
+
+   return(tch.adr);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Return the block ID containing the given element ID                        */
+/* Clear the part of a table that belongs to a range of lines                 */
 /*----------------------------------------------------------------------------*/
 
-int GetBlkIdx(int64_t ParIdx, int typ, int idx)
+static void TchBlk(itg BegIdx, itg EndIdx, int PthIdx, void *arg)
 {
-   ParSct *par = (ParSct *)ParIdx;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(-1);
+   TchSct *tch = (TchSct *)arg;
+   (void)(PthIdx);
 
-   return( (idx - 1) / par->TypTab[ typ ].SmlWrkSiz );
+   memset(&tch->adr[ BegIdx * tch->EntSiz ], 0, (EndIdx - BegIdx + 1) * tch->EntSiz);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Check whether two blocks are dependant or not from each others             */
+/* Clear the pages of a table given to a thread's rank                        */
 /*----------------------------------------------------------------------------*/
 
-int ChkBlkDep(int64_t ParIdx, int TypIdx, int blk1, int blk2)
+static void TchPag(itg BegIdx, itg EndIdx, int PthIdx, void *arg)
 {
-   ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(-1);
+   itg      rnk;
+   TchSct   *tch = (TchSct *)arg;
+   char     *BegAdr, *EndAdr = tch->adr + tch->TotSiz, *PagAdr;
+   (void)(PthIdx);
 
-   typ = &par->TypTab[ TypIdx ];
+   for(rnk=BegIdx-1; rnk<EndIdx; rnk++)
+   {
+      PagAdr = tch->adr - (size_t)tch->adr % tch->PagSiz + rnk * tch->PagSiz;
 
-   return(AndWrd( typ->NmbDepWrd,
-                  typ->SmlWrkTab[ blk1 ].DepWrdTab,
-                  typ->SmlWrkTab[ blk2 ].DepWrdTab ));
+      for(; PagAdr < EndAdr; PagAdr += tch->NmbPth * tch->PagSiz)
+      {
+         BegAdr = MAX(PagAdr, tch->adr);
+         memset(BegAdr, 0, MIN(PagAdr + tch->PagSiz, EndAdr) - BegAdr);
+      }
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Test and set a bit in a multibyte word                                     */
+/* Start recording the launches into a new graph                              */
 /*----------------------------------------------------------------------------*/
 
-static int SetBit(int *tab, int idx)
+int BeginCapture(int64_t ParIdx)
 {
-   int res = ( tab[ idx >> 5 ] & (1UL << (idx & 31)) );
-   tab[ idx >> 5 ] |= 1UL << (idx & 31);
-   return(res);
-}
+   int      i;
+   ParSct   *par = (ParSct *)ParIdx;
 
+   // Get and check lib parallel instance and that no capture is running
+   if(!ParIdx || par->CapGrf)
+      return(0);
 
-/*----------------------------------------------------------------------------*/
-/* Test a bit in a multibyte word                                             */
-/*----------------------------------------------------------------------------*/
+   for(i=0;i<MaxGrf;i++)
+      if(!par->GrfTab[i].use)
+         break;
 
-static int GetBit(int *tab, int idx)
-{
-   return( tab[ idx >> 5 ] & (1UL << (idx & 31)) );
-}
+   if(i == MaxGrf)
+      return(0);
 
+   memset(&par->GrfTab[i], 0, sizeof(GrfSct));
+   par->GrfTab[i].use = 1;
+   par->CapGrf = i + 1;
 
-/*----------------------------------------------------------------------------*/
-/* Clear a bit in a multibyte word                                            */
-/*----------------------------------------------------------------------------*/
+   // Dynamic dependency loops record their schedule to be replayed resident
+   par->RplFrc = 1;
 
-static void ClrBit(int *tab, int idx)
-{
-   tab[ idx >> 5 ] &= ~(1UL << (idx & 31));
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Check wether two WP share common resources -> locked                       */
+/* Stop recording and return the graph's index                                */
 /*----------------------------------------------------------------------------*/
 
-static int AndWrd(int NmbWrd, int *wrd1, int *wrd2)
+int EndCapture(int64_t ParIdx)
 {
-   int i;
-
-   for(i=0;i<NmbWrd;i++)
-      if(wrd1[i] & wrd2[i])
-         return(1);
-
-   return(0);
-}
-
+   int      GrfIdx;
+   ParSct   *par = (ParSct *)ParIdx;
 
-/*----------------------------------------------------------------------------*/
-/* Logical OR between two multibyte words                                     */
-/*----------------------------------------------------------------------------*/
+   if(!ParIdx || !par->CapGrf)
+      return(0);
 
-static void AddWrd(int NmbWrd, int *SrcWrd, int *DstWrd)
-{
-   int i;
+   GrfIdx = par->CapGrf;
+   par->CapGrf = par->RplFrc = 0;
+   UpdMem(par, 0);
 
-   for(i=0;i<NmbWrd;i++)
-      DstWrd[i] |= SrcWrd[i];
+   return(GrfIdx);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Exclusive OR between two multibyte words                                   */
+/* Free a graph and its captured launches                                     */
 /*----------------------------------------------------------------------------*/
 
-static void SubWrd(int NmbWrd, int *SrcWrd, int *DstWrd)
+void FreeGraph(int64_t ParIdx, int GrfIdx)
 {
-   int i;
-
-   for(i=0;i<NmbWrd;i++)
-      DstWrd[i] &= ~SrcWrd[i];
-}
+   GrfSct   *grf;
+   ParSct   *par = (ParSct *)ParIdx;
 
+   if(!ParIdx || (GrfIdx < 1) || (GrfIdx > MaxGrf) || (GrfIdx == par->CapGrf))
+      return;
 
-/*----------------------------------------------------------------------------*/
-/* Clear a multibyte word                                                     */
-/*----------------------------------------------------------------------------*/
+   grf = &par->GrfTab[ GrfIdx - 1 ];
 
-static void ClrWrd(int NmbWrd, int *wrd)
-{
-   int i;
+   if(grf->CapTab)
+      LPL_free(par->lmb, grf->CapTab);
 
-   for(i=0;i<NmbWrd;i++)
-      wrd[i] = 0;
+   memset(grf, 0, sizeof(GrfSct));
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Copy a multibyte word into another one                                     */
+/* Append a launch to the graph being captured                                */
 /*----------------------------------------------------------------------------*/
 
-static void CpyWrd(int NmbWrd, int *SrcWrd, int *DstWrd)
+static void AddCap(  ParSct *par, int cmd, int TypIdx1, int TypIdx2,
+                     void *prc, void *arg, void *adr, size_t siz )
 {
-   int i;
-
-   for(i=0;i<NmbWrd;i++)
-      DstWrd[i] = SrcWrd[i];
-}
-
+   GrfSct   *grf = &par->GrfTab[ par->CapGrf - 1 ];
+   CapSct   *cap, *NewTab;
 
-/*----------------------------------------------------------------------------*/
-/* Compare two workpackages number of bits                                    */
-/*----------------------------------------------------------------------------*/
+   if(grf->NmbCap == grf->MaxCap)
+   {
+      if(!(NewTab = LPL_malloc(par->lmb, MAX(16, 2 * grf->MaxCap) * sizeof(CapSct))))
+         return;
 
-int CmpWrk(const void *ptr1, const void *ptr2)
-{
-   WrkSct *w1, *w2;
+      if(grf->CapTab)
+      {
+         memcpy(NewTab, grf->CapTab, grf->NmbCap * sizeof(CapSct));
+         LPL_free(par->lmb, grf->CapTab);
+      }
 
-   w1 = (WrkSct *)ptr1;
-   w2 = (WrkSct *)ptr2;
+      grf->CapTab = NewTab;
+      grf->MaxCap = MAX(16, 2 * grf->MaxCap);
+   }
 
-   if(w1->NmbDep > w2->NmbDep)
-      return(-1);
-   else if(w1->NmbDep < w2->NmbDep)
-      return(1);
-   else
-      return(0);
+   cap = &grf->CapTab[ grf->NmbCap++ ];
+   cap->cmd = cmd;
+   cap->TypIdx1 = TypIdx1;
+   cap->TypIdx2 = TypIdx2;
+   cap->prc = prc;
+   cap->arg = arg;
+   cap->ClrAdr = (char *)adr;
+   cap->ClrSiz = siz;
+   cap->NmbVarArg = par->NmbVarArg;
+   cap->PrcWid = par->PrcWid;
+   memcpy(cap->VarArgTab, par->VarArgTab, MaxVarArg * sizeof(void *));
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Generate static scheduling groups of small WP for each thread              */
+/* Replay a captured graph: stretches of launches whose WP are known in       */
+/* advance run with a single wake-up of the threads that stay resident and    */
+/* only go through barriers between launches                                  */
 /*----------------------------------------------------------------------------*/
 
-static int SetGrp(ParSct *par, TypSct *typ)
+int ReplayGraph(int64_t ParIdx, int GrfIdx)
 {
-   int      i, NmbSmlWrk, *GrpWrd, *AllWrd, *TstWrd;
-   int      IncFlg, siz = typ->NmbDepWrd;
-   GrpSct   *grp;
-   WrkSct   *wrk, *NexWrk;
-
-   // Initialize the static group list
-   NmbSmlWrk = typ->NmbSmlWrk;
-   typ->NmbGrp = 0;
-   typ->NexGrp = NULL;
-
-   // Allocate a dependency word to contain all threads
-   if(!(GrpWrd = LPL_malloc(par->lmb, par->NmbCpu * siz * sizeof(int))))
-      return(0);
-
-   // Allocate a dependency word to concatenate all thread words
-   if(!(AllWrd = LPL_malloc(par->lmb, siz * sizeof(int))))
-      return(0);
-
-   // Allocate a working dependency word for testings
-   if(!(TstWrd = LPL_malloc(par->lmb, siz * sizeof(int))))
-      return(0);
-
-   // Link all WP together to make a free list
-   NexWrk = &typ->SmlWrkTab[0];
+   int      i, j;
+   GrfSct   *grf;
+   ParSct   *par = (ParSct *)ParIdx;
 
-   for(i=0;i<typ->NmbSmlWrk;i++)
+   if( !ParIdx || (GrfIdx < 1) || (GrfIdx > MaxGrf)
+   ||  !par->GrfTab[ GrfIdx - 1 ].use || par->CapGrf )
    {
-      typ->SmlWrkTab[i].pre = &typ->SmlWrkTab[ i - 1 ];
-      typ->SmlWrkTab[i].nex = &typ->SmlWrkTab[ i + 1 ];
+      return(0);
    }
 
-   typ->SmlWrkTab[0].pre = NULL;
-   typ->SmlWrkTab[ typ->NmbSmlWrk - 1 ].nex = NULL;
+   grf = &par->GrfTab[ GrfIdx - 1 ];
 
-   // Kepp on creating new groups as long as there are free WP
-   do
+   for(i=0;i<grf->NmbCap;i=j)
    {
-      // Allocate a new group and link it
-      if(!(grp = LPL_calloc(par->lmb, 1, sizeof(GrpSct))))
-         return(0);
-
-      grp->nex = typ->NexGrp;
-      typ->NexGrp = grp;
-      grp->idx = ++typ->NmbGrp;
-
-      // Reset all the dependencies words
-      memset(GrpWrd, 0, par->NmbCpu * siz * sizeof(int));
-      memset(AllWrd, 0, siz * sizeof(int));
-
-      // Keep on adding WP to each groups' threads until they reach WrkPerGrp
-      do
+      // A launch whose schedule is not known goes through the regular path
+      if(!ResCap(par, &grf->CapTab[i]))
       {
-         // Could we add some WP to this group during this iteration ?
-         IncFlg = 0;
-
-         // Loop over the threads and try adding them as many WP as possible
-         for(i=0;i<par->NmbCpu;i++)
-         {
-            // Do not add WP is this threads has reached its target number
-            if(!NexWrk || (grp->NmbSmlWrk[i] >= WrkPerGrp))
-               continue;
-
-            // Initialize the WP pointer with the first
-            // available one from the linked list
-            wrk = NexWrk;
-
-            // Then loop over the linked list of available WP and add them to
-            // the curent group-thread list as long as they do not interfere
-            // with the combined dependency word of other threads
-            do
-            {
-               // To avoid making a AND with all threads' words, we remode (XOR)
-               // the tested thread' word from the combined one and test (AND)
-               // it against this WP's word
-               CpyWrd(siz, AllWrd, TstWrd);
-               SubWrd(siz, &GrpWrd[ i * siz ], TstWrd);
-
-               if(!AndWrd(siz, wrk->DepWrdTab, TstWrd))
-               {
-                  // If this WP is compatible, add its word to the thread
-                  // dependency word and to the combined one
-                  AddWrd(siz, wrk->DepWrdTab, AllWrd);
-                  AddWrd(siz, wrk->DepWrdTab, &GrpWrd[ i * siz ]);
-
-                  // Add this WP to the list, decrease the number of available
-                  // WPs and set the flag to indicate that we found some work
-                  grp->SmlWrkTab[i][ grp->NmbSmlWrk[i] ] = wrk;
-                  grp->NmbSmlWrk[i]++;
-                  NmbSmlWrk--;
-                  IncFlg = 1;
-
-                  // Unlink the WP from the available WP linked list
-                  if(wrk->pre)
-                     wrk->pre->nex = wrk->nex;
-                  else
-                     NexWrk = wrk->nex;
-
-                  if(wrk->nex)
-                     wrk->nex->pre = wrk->pre;
-               }
-
-               // Stop adding WP to this group-thread if its table is full
-               if(grp->NmbSmlWrk[i] >= WrkPerGrp)
-                  break;
-
-               wrk = wrk->nex;
-            }while(wrk && NmbSmlWrk);
-         }
-      }while(IncFlg && NmbSmlWrk);
-   }while(NmbSmlWrk);
-
-   LPL_free(par->lmb, GrpWrd);
-   LPL_free(par->lmb, AllWrd);
-   LPL_free(par->lmb, TstWrd);
-
-   return(1);
-}
-
-
-/*----------------------------------------------------------------------------*/
-/* Launch a colorgrain parallel procudure with variable arguments.            */
-/* Arguments are passed as pointer to void.                                   */
-/*----------------------------------------------------------------------------*/
+         RunCap(par, &grf->CapTab[i]);
+         j = i + 1;
+         continue;
+      }
 
-float LaunchColorGrainsMultiArg( int64_t ParIdx, int typ,
-                                 void *prc, int NmbArg, ... )
-{
-   int i;
-   float acc;
-   va_list ArgLst;
-   ParSct *par = (ParSct *)ParIdx;
+      for(j=i+1; (j < grf->NmbCap) && ResCap(par, &grf->CapTab[j]); j++);
 
-   if(NmbArg > 20)
-      return(-1.);
+      pthread_mutex_lock(&par->ParMtx);
 
-   par->NmbVarArg = NmbArg;
-   va_start(ArgLst, NmbArg);
+      par->cmd = RunGrfWrk;
+      par->CurGrf = grf;
+      par->GrfBeg = i;
+      par->GrfEnd = j;
+      par->WrkCpt = par->BarCnt = 0;
+      SetCap(par, &grf->CapTab[i]);
 
-   for(i=0;i<NmbArg;i++)
-      par->VarArgTab[i] = va_arg(ArgLst, void *);
+      RunTre(par, par->NmbCpu);
 
-   va_end(ArgLst);
+      pthread_mutex_unlock(&par->ParMtx);
+   }
 
-   acc = LaunchColorGrains(ParIdx, typ, prc, NULL);
+   par->typ1 = NULL;
    par->NmbVarArg = 0;
+   par->PrcWid = LplLng;
 
-   return(acc);
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Launch the loop prc on typ1 element depending on typ2                      */
+/* Check whether a captured launch can run with resident threads              */
 /*----------------------------------------------------------------------------*/
 
-float LaunchColorGrains(int64_t ParIdx, int typ, void *prc, void *PtrArg)
+static int ResCap(ParSct *par, CapSct *cap)
 {
-   int      i;
-   float    acc = 0.;
-   PthSct   *pth;
-   ParSct   *par = (ParSct *)ParIdx;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(-1.);
+   TypSct *typ1 = &par->TypTab[ cap->TypIdx1 ];
 
-   // Lock acces to global parameters
-   pthread_mutex_lock(&par->ParMtx);
+   switch(cap->cmd)
+   {
+      // Interleaved blocks may need to be rebuilt by LaunchParallel
+      case RunBigWrk :
+         return( (par->NmbItlBlk == 1) && !par->ItlBlkSiz && (typ1->NmbItlBlk <= 1) );
 
-   par->cmd = RunGrnWrk;
-   par->prc = (void (*)(itg, itg, int, void *))prc;
-   par->arg = PtrArg;
-   par->typ1 = NULL;
-   par->typ2 = NULL;
-   par->NexWrk = par->GrnWrkTab;
-   par->WrkCpt = 0;
-   par->sta[0] = par->sta[1] = 0.;
-   par->req = 0;
-   par->NmbDep = 0;
-   par->CurCol = 1;
+      // Static groups or a recorded dynamic schedule are needed
+      case RunSmlWrk :
+      {
+         if(!par->DynSch)
+            return(typ1->NexGrp != NULL);
 
-   // Clear running wp
-   for(i=0;i<par->NmbCpu;i++)
-      par->PthTab[i].wrk = NULL;
+         return( (typ1->RplTyp == cap->TypIdx2) && !typ1->AdpUpd );
+      }
 
-   ClrWrd(par->NmbGrnWrd, par->RunGrnTab);
+      case RunGrnWrk :
+         return(par->GrnTab[ cap->TypIdx1 ] && par->NmbCol);
 
-   // Build a linked list of wp
-   for(i=0;i<par->NmbGrnWrk;i++)
-   {
-      par->GrnWrkTab[i].pre = &par->GrnWrkTab[ i-1 ];
-      par->GrnWrkTab[i].nex = &par->GrnWrkTab[ i+1 ];
-      par->GrnWrkTab[i].GrnIdx = i + 1;
-      par->GrnWrkTab[i].BegIdx = par->GrnTab[ typ ][i+1][0];
-      par->GrnWrkTab[i].EndIdx = par->GrnTab[ typ ][i+1][1];
+      case ClrMem :
+         return(1);
    }
 
-   par->GrnWrkTab[0].pre = par->GrnWrkTab[ par->NmbGrnWrk - 1 ].nex = NULL;
+   return(0);
+}
 
-   for(i=1;i<=par->NmbCol;i++)
-      par->ColCpt[i] = par->ColTab[i][1] - par->ColTab[i][0] + 1;
 
+/*----------------------------------------------------------------------------*/
+/* Run a captured launch through the regular path, recording its schedule     */
+/*----------------------------------------------------------------------------*/
 
-   // Main loop: wake up threads and wait for completion or blocked threads
-   do
-   {
-      // Search for some idle threads
-      par->req = 0;
+static void RunCap(ParSct *par, CapSct *cap)
+{
+   par->NmbVarArg = cap->NmbVarArg;
+   par->PrcWid = cap->PrcWid;
+   memcpy(par->VarArgTab, cap->VarArgTab, MaxVarArg * sizeof(void *));
 
-      for(i=0;i<par->NmbCpu;i++)
-      {
-         pth = &par->PthTab[i];
+   if(cap->cmd == RunGrnWrk)
+      LchGrn(par, cap->PrcWid, cap->TypIdx1, cap->prc, cap->arg);
+   else
+   {
+      par->RplFrc = 1;
+      LchPar(par, cap->TypIdx1, cap->TypIdx2, cap->prc, cap->arg);
+      par->RplFrc = 0;
+   }
 
-         if(pth->wrk)
-            continue;
+   par->NmbVarArg = 0;
+   par->PrcWid = LplLng;
+}
 
-         if(!(pth->wrk = NexGrn(par, i)))
-         {
-            par->req = 1;
-            break;
-         }
 
-         // Wake up the thread and provide it with a WP list
-         pthread_mutex_lock(&pth->mtx);
-         pthread_cond_signal(&pth->cnd);
-         pthread_mutex_unlock(&pth->mtx);
-      }
+/*----------------------------------------------------------------------------*/
+/* Set the shared parameters of a captured launch, while no thread runs       */
+/*----------------------------------------------------------------------------*/
 
-      // If every WP are done : exit the parallel loop
-      if(par->WrkCpt == par->NmbGrnWrk)
-         break;
+static void SetCap(ParSct *par, CapSct *cap)
+{
+   int      i;
+   TypSct   *typ1 = &par->TypTab[ cap->TypIdx1 ];
 
-      // Otherwise, wait for a blocked thread
-      pthread_cond_wait(&par->ParCnd, &par->ParMtx);
-   }while(1);
+   par->prc = (void (*)(itg, itg, int, void *))cap->prc;
+   par->arg = cap->arg;
+   par->NmbVarArg = cap->NmbVarArg;
+   par->PrcWid = cap->PrcWid;
+   memcpy(par->VarArgTab, cap->VarArgTab, MaxVarArg * sizeof(void *));
 
-   pthread_mutex_unlock(&par->ParMtx);
+   if(cap->cmd == RunBigWrk)
+   {
+      par->typ1 = typ1;
 
-   // Compute the average concurrency factor
-   acc = par->sta[0] ? (par->sta[1] / par->sta[0]) : 0;
+      for(i=0;i<par->NmbCpu;i++)
+         par->PthTab[i].big = &typ1->BigWrkTab[i];
+   }
+   else if(cap->cmd == RunSmlWrk)
+   {
+      par->typ1 = typ1;
 
-   // Clear the main datatyp loop to indicate that no LaunchParallel is running
-   par->typ1 = 0;
+      for(i=0;i<par->NmbCpu;i++)
+         par->PthTab[i].DonGrp = 0;
 
-   // Return the concurrency factor
-   return(acc);
+      par->RplWai = 0;
+      typ1->RplEpo++;
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Tell the pthread handler to clear a chunmk of memory in parallel           */
+/* Run a thread's part of a stretch of captured launches                      */
 /*----------------------------------------------------------------------------*/
 
-int ParallelMemClear(int64_t ParIdx, void *PtrArg, size_t siz)
+static void RunGrf(ParSct *par, PthSct *pth)
 {
-   int      i;
-   size_t   StdSiz, EndSiz;
-   PthSct   *pth;
-   ParSct   *par = (ParSct *)ParIdx;
-   char     *tab = (char *)PtrArg;
-
-   // Get and check lib parallel instance, adresse and size
-   if(!ParIdx || !tab)
-      return(0);
+   int      i, c, g;
+   size_t   off;
+   CapSct   *cap;
 
-   // If the memory chunk is too small, clear it sequentially
-   if(siz < BigMemSiz || par->NmbCpu == 1)
+   for(i=par->GrfBeg; i<par->GrfEnd; i++)
    {
-      memset(PtrArg, 0, siz);
-      return(1);
-   }
+      cap = &par->CurGrf->CapTab[i];
 
-   // Lock acces to global parameters
-   pthread_mutex_lock(&par->ParMtx);
+      switch(cap->cmd)
+      {
+         case RunBigWrk :
+            RunBig(par, pth);
+         break;
 
-   par->cmd = ClrMem;
-   par->WrkCpt = 0;
+         case RunSmlWrk :
+         {
+            if(par->DynSch)
+               RunRpl(par, pth);
+            else
+               RunDet(par, pth);
+         }break;
 
-   // Share the size between threads and adjust the value of the final one
-   StdSiz = siz / par->NmbCpu;
-   EndSiz = siz - StdSiz * (par->NmbCpu - 1);
+         // Grains of a color are dealt in turn to the threads
+         case RunGrnWrk :
+         {
+            for(c=1;c<=par->NmbCol;c++)
+            {
+               for(g = par->ColTab[c][0] + pth->idx; g <= par->ColTab[c][1]; g += par->NmbCpu)
+                  CalPrc(par, par->GrnTab[ cap->TypIdx1 ][g][0],
+                         par->GrnTab[ cap->TypIdx1 ][g][1], g);
 
-   // Spread the buffer among each thread and wake then up
-   for(i=0;i<par->NmbCpu;i++)
-   {
-      pth = &par->PthTab[i];
-      pth->ClrAdr = &tab[ i * StdSiz ];
+               if(c < par->NmbCol)
+                  GrfBar(par, NULL);
+            }
+         }break;
 
-      // The last thread processes the remaining size
-      if(i < par->NmbCpu - 1)
-         pth->ClrMemSiz = StdSiz;
-      else
-         pth->ClrMemSiz = EndSiz;
+         // Small chunks are cleared by the first thread
+         case ClrMem :
+         {
+            if(!ParMem(par, 0, cap->ClrSiz))
+            {
+               if(!pth->idx)
+                  ClrKer(cap->ClrAdr, cap->ClrSiz, cap->ClrSiz > par->LlcSiz);
+            }
+            else
+            {
+               off = SlcOff(par, cap->ClrAdr, cap->ClrSiz, 1, pth->idx);
+               ClrKer(&cap->ClrAdr[ off ],
+                      SlcOff(par, cap->ClrAdr, cap->ClrSiz, 1, pth->idx + 1) - off,
+                      cap->ClrSiz > par->LlcSiz);
+            }
+         }break;
+      }
 
-      pthread_mutex_lock(&pth->mtx);
-      pthread_cond_signal(&pth->cnd);
-      pthread_mutex_unlock(&pth->mtx);
+      // Each launch depends on the former ones
+      if(i + 1 < par->GrfEnd)
+         GrfBar(par, &par->CurGrf->CapTab[ i+1 ]);
    }
-
-   // Wait for each thread to complete
-   while(par->WrkCpt < par->NmbCpu)
-      pthread_cond_wait(&par->ParCnd, &par->ParMtx);
-
-   pthread_mutex_unlock(&par->ParMtx);
-
-   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Tell the pthread handler to copy a chunmk of memory in parallel            */
+/* Wait for all threads, the last one to arrive sets the next launch          */
 /*----------------------------------------------------------------------------*/
 
-int ParallelMemCopy(int64_t ParIdx, void *PtrDst, void *PtrSrc, size_t siz)
+static void GrfBar(ParSct *par, CapSct *cap)
 {
-   int      i;
-   PthSct   *pth;
-   ParSct   *par = (ParSct *)ParIdx;
-   size_t   StdSiz, EndSiz;
-   char     *DstTab = (char *)PtrDst;
-   char     *SrcTab = (char *)PtrSrc;
-
-   // Get and check lib parallel instance, adresse and size
-   if(!ParIdx || !PtrDst || !PtrSrc)
-      return(0);
+   int BarGen;
 
-   // If the memory chunk is too small, clear it sequentially
-   if(siz < BigMemSiz || par->NmbCpu == 1)
-   {
-      memcpy(PtrDst, PtrSrc, siz);
-      return(1);
-   }
-
-   // Lock acces to global parameters
-   pthread_mutex_lock(&par->ParMtx);
-
-   par->cmd = CpyMem;
-   par->WrkCpt = 0;
+   pthread_mutex_lock(&par->GrpMtx);
+   BarGen = par->BarGen;
 
-   // Share the size between threads and adjust the value of the final one
-   StdSiz = siz / par->NmbCpu;
-   EndSiz = siz - StdSiz * (par->NmbCpu - 1);
-
-   // Spread the buffer among each thread and wake then up
-   for(i=0;i<par->NmbCpu;i++)
+   if(++par->BarCnt == par->NmbCpu)
    {
-      pth = &par->PthTab[i];
-      pth->DstAdr = &DstTab[ i * StdSiz ];
-      pth->SrcAdr = &SrcTab[ i * StdSiz ];
+      par->BarCnt = 0;
+      par->BarGen++;
 
-      // The last thread processes the remaining size
-      if(i < par->NmbCpu - 1)
-         pth->CpyMemSiz = StdSiz;
-      else
-         pth->CpyMemSiz = EndSiz;
+      if(cap)
+         SetCap(par, cap);
 
-      pthread_mutex_lock(&pth->mtx);
-      pthread_cond_signal(&pth->cnd);
-      pthread_mutex_unlock(&pth->mtx);
+      pthread_cond_broadcast(&par->GrpCnd);
    }
+   else
+      while(BarGen == par->BarGen)
+         pthread_cond_wait(&par->GrpCnd, &par->GrpMtx);
 
-   // Wait for each thread to complete
-   while(par->WrkCpt < par->NmbCpu)
-      pthread_cond_wait(&par->ParCnd, &par->ParMtx);
-
-   pthread_mutex_unlock(&par->ParMtx);
-
-   return(1);
+   pthread_mutex_unlock(&par->GrpMtx);
 }
 
 
@@ -2436,7 +8209,7 @@ int LaunchPipeline(  int64_t ParIdx, void *prc,
       return(0);
 
    // Allocate and setup a new pipe
-   if(!(NewPip = LPL_calloc(par->lmb, 1, sizeof(PipSct))))
+   if(!(NewPip = GetBlk(par, &par->PipArn)))
       return(0);
 
    NewPip->prc = prc;
@@ -2463,24 +8236,46 @@ int LaunchPipeline(  int64_t ParIdx, void *prc,
    NewPip->idx = ++par->NmbPip;
    par->PenPip++;
 
+   // With critical path priorities, the pipe is listed among the waiting ones
+   // and the pipes it depends on get longer chains of dependent pipes
+   if( par->CrtPth && (par->PipTab ||
+      (par->PipTab = LPL_calloc(par->lmb, MaxTotPip + 1, sizeof(PipSct *)))) )
+   {
+      par->PipTab[ NewPip->idx ] = NewPip;
+      NewPip->nex = par->WaiPip;
+
+      if(par->WaiPip)
+         par->WaiPip->pre = NewPip;
+
+      par->WaiPip = NewPip;
+
+      for(i=0;i<NmbDep;i++)
+         if( (DepTab[i] > 0) && (DepTab[i] <= MaxTotPip) && par->PipTab[ DepTab[i] ] )
+            RaiPip(par, par->PipTab[ DepTab[i] ], 1.);
+   }
+
    if(par->StkSiz)
    {
       pthread_attr_init(&NewPip->atr);
       NewPip->StkSiz = par->StkSiz;
-      NewPip->UsrStk = LPL_malloc(par->lmb, par->StkSiz);
+      NewPip->UsrStk = GetBlk(par, &par->StkArn);
 #ifdef _WIN32
       pthread_attr_setstackaddr(&NewPip->atr, NewPip->UsrStk);
       pthread_attr_setstacksize(&NewPip->atr, NewPip->StkSiz);
 #else
       pthread_attr_setstack(&NewPip->atr, NewPip->UsrStk, NewPip->StkSiz);
 #endif
+      // The thread is joined by the next pipe that gets its stack back
       pthread_create(&NewPip->pth, &NewPip->atr, PipHdl, (void *)NewPip);
    }
    else
+   {
       pthread_create(&NewPip->pth, NULL, PipHdl, (void *)NewPip);
 
-   // Make the thread unjoinable to work around a memory leak in some systems
-   pthread_detach(NewPip->pth);
+      // Make the thread unjoinable to work around a memory leak in some systems
+      pthread_detach(NewPip->pth);
+   }
+
    pthread_mutex_unlock(&par->PipMtx);
 
    return(NewPip->idx);
@@ -2521,14 +8316,43 @@ int LaunchPipelineMultiArg(int64_t ParIdx, int NmbDep, int *DepTab,
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* Set the priority of a pipe still waiting for its dependencies, only pipes  */
+/* launched with critical path priorities are concerned                       */
+/*----------------------------------------------------------------------------*/
+
+int SetPipelinePriority(int64_t ParIdx, int PipIdx, float pri)
+{
+   int      ret = 0;
+   PipSct   *pip;
+   ParSct   *par = (ParSct *)ParIdx;
+
+   if(!ParIdx || (PipIdx < 1) || (PipIdx > MaxTotPip))
+      return(0);
+
+   pthread_mutex_lock(&par->PipMtx);
+
+   if(par->PipTab && (pip = par->PipTab[ PipIdx ]))
+   {
+      pip->pri = pri;
+      pip->UsrPri = 1;
+      ret = 1;
+   }
+
+   pthread_mutex_unlock(&par->PipMtx);
+
+   return(ret);
+}
+
+
 /*----------------------------------------------------------------------------*/
 /* Thread handler launching and waitint for user's procedure                  */
 /*----------------------------------------------------------------------------*/
 
 static void *PipHdl(void *ptr)
 {
-   int RunFlg=0, i;
-   PipSct *pip = (PipSct *)ptr;
+   int RunFlg=0;
+   PipSct *pip = (PipSct *)ptr, *nex;
    ParSct *par = pip->par;
    void (*prc)(void *), (*prcgrn)(int, int, int, void *);
 #ifndef _WIN32
@@ -2545,7 +8369,7 @@ static void *PipHdl(void *ptr)
       pthread_mutex_lock(&par->PipMtx);
       par->PenPip--;
       par->RunPip--;
-      LPL_free(par->lmb, pip);
+      PutBlk(&par->PipArn, pip, 0);
       pthread_mutex_unlock(&par->PipMtx);
    }
    else
@@ -2557,14 +8381,16 @@ static void *PipHdl(void *ptr)
 
          if(par->RunPip < par->NmbCpu)
          {
-            RunFlg = 1;
-
-            for(i=0;i<pip->NmbDep;i++)
-               if(!GetBit(par->PipWrd, pip->DepTab[i]))
-               {
-                  RunFlg = 0;
-                  break;
-               }
+            RunFlg = ChkPip(par, pip);
+
+            // Give way to a ready pipe of higher priority
+            if(RunFlg && par->PipTab && (par->PipTab[ pip->idx ] == pip))
+               for(nex = par->WaiPip; nex; nex = nex->nex)
+                  if( (nex->pri > pip->pri) && ChkPip(par, nex) )
+                  {
+                     RunFlg = 0;
+                     break;
+                  }
          }
 
          if(!RunFlg)
@@ -2584,6 +8410,18 @@ static void *PipHdl(void *ptr)
       prc = (void (*)(void *))pip->prc;
       par->RunPip++;
 
+      // Remove the pipe from the waiting ones
+      if(par->PipTab && (par->PipTab[ pip->idx ] == pip))
+      {
+         if(pip->pre)
+            pip->pre->nex = pip->nex;
+         else
+            par->WaiPip = pip->nex;
+
+         if(pip->nex)
+            pip->nex->pre = pip->pre;
+      }
+
       pthread_mutex_unlock(&par->PipMtx);
 
       if(pip->NmbVarArg)
@@ -2595,13 +8433,65 @@ static void *PipHdl(void *ptr)
 
       SetBit(par->PipWrd, pip->idx);
 
-      par->PenPip--;
-      par->RunPip--;
-      LPL_free(par->lmb, pip);
-      pthread_mutex_unlock(&par->PipMtx);
+      if(par->PipTab && (par->PipTab[ pip->idx ] == pip))
+         par->PipTab[ pip->idx ] = NULL;
+
+      par->PenPip--;
+      par->RunPip--;
+
+      // This thread still runs on its stack, it is given back along
+      // with the thread's id so that it is not reused before its exit
+      if(pip->UsrStk)
+      {
+         pthread_attr_destroy(&pip->atr);
+         PutBlk(&par->StkArn, pip->UsrStk, 1);
+      }
+
+      PutBlk(&par->PipArn, pip, 0);
+      pthread_mutex_unlock(&par->PipMtx);
+   }
+
+   return(NULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Check whether all the pipes a pipe depends on are completed                */
+/*----------------------------------------------------------------------------*/
+
+static int ChkPip(ParSct *par, PipSct *pip)
+{
+   int i;
+
+   for(i=0;i<pip->NmbDep;i++)
+      if(!GetBit(par->PipWrd, pip->DepTab[i]))
+         return(0);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Raise a waiting pipe's priority to the length of the chain of pipes        */
+/* depending on it and propagate it to the pipes it depends on                */
+/*----------------------------------------------------------------------------*/
+
+static void RaiPip(ParSct *par, PipSct *pip, float pri)
+{
+   int i, dep;
+
+   if(pip->UsrPri || (pri <= pip->pri))
+      return;
+
+   pip->pri = pri;
+
+   for(i=0;i<pip->NmbDep;i++)
+   {
+      dep = pip->DepTab[i];
+
+      if( (dep > 0) && (dep <= MaxTotPip) && par->PipTab[ dep ] )
+         RaiPip(par, par->PipTab[ dep ], pri + 1.);
    }
-
-   return(NULL);
 }
 
 
@@ -2660,6 +8550,195 @@ void GetLplibInformation(int64_t ParIdx, int *NmbCpu, int *NmbTyp)
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* Get the bytes the library holds per category and per type, along with the  */
+/* peaks sampled at the end of each call allocating tables                    */
+/*----------------------------------------------------------------------------*/
+
+int GetMemoryUsage(int64_t ParIdx, LplMemSct *mem)
+{
+   int      i;
+   ParSct   *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx || !mem)
+      return(0);
+
+   // Sum the sizes again, tables freed since the last update included
+   for(i=0;i<=MaxTyp;i++)
+      UpdMem(par, i);
+
+   memcpy(mem, &par->MemCur, sizeof(LplMemSct));
+   mem->TotPek = par->MemPek.TotPek;
+   memcpy(mem->CatPek, par->MemPek.CatPek, sizeof(mem->CatPek));
+   memcpy(mem->TypPek, par->MemPek.TypPek, sizeof(mem->TypPek));
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sum the sizes of a type's tables, or the instance's ones if TypIdx is 0,   */
+/* per category from their dimensions, the ones whose dimensions change       */
+/* after their allocation keep their own size                                 */
+/*----------------------------------------------------------------------------*/
+
+static void GetMem(ParSct *par, int TypIdx, size_t *CatSiz)
+{
+   int      i;
+   size_t   ItlSiz = sizeof(BigSct) + MaxItlBlk * 2 * sizeof(itg);
+   TypSct   *typ = &par->TypTab[ TypIdx ];
+   TunSct   *tun;
+
+   memset(CatSiz, 0, LplMemMax * sizeof(size_t));
+
+   if(TypIdx)
+   {
+      if(!typ->NmbLin)
+         return;
+
+      // Small and big WP, entities' costs and priorities
+      CatSiz[ LplMemBlocks ] += typ->MaxSmlWrk * sizeof(WrkSct);
+
+      if(typ->BigWrkTab)
+         CatSiz[ LplMemBlocks ] += par->NmbCpu * par->SizMul * ItlSiz;
+
+      if(typ->CstSum)
+         CatSiz[ LplMemBlocks ] += (typ->CstLin + 1) * sizeof(double);
+
+      if(typ->PriTab)
+         CatSiz[ LplMemBlocks ] += (typ->NmbLin + 1) * sizeof(float);
+
+      // Dependency matrices as mapped and running words
+      if(typ->DepWrdMat)
+         CatSiz[ LplMemDependencies ] += HugSiz(typ->DepWrdMat,
+                     (size_t)typ->MaxDepRow * typ->DepWrdStr * sizeof(int));
+
+      if(typ->RunDepTab)
+         CatSiz[ LplMemDependencies ] += typ->DepWrdStr * sizeof(int);
+
+      if(typ->PriBit)
+         CatSiz[ LplMemDependencies ] += typ->DepWrdStr * 32 * sizeof(float);
+
+      if(typ->NodDepMat)
+         CatSiz[ LplMemDependencies ] += HugSiz(typ->NodDepMat,
+                     (size_t)typ->NmbNod * typ->NmbDepWrd * sizeof(int));
+
+      // Adaptive tree, affinity list, groups' waits, replay and ordering
+      CatSiz[ LplMemSchedules ] += typ->NmbNod * sizeof(NodSct)
+            + typ->MaxAff * (sizeof(WrkSct *) + sizeof(int)) + typ->RplSiz + typ->OrdSiz
+            + (size_t)typ->NmbGrp * par->NmbCpu * par->NmbCpu * sizeof(int);
+
+#if ( __STDC_VERSION__ > 201100L )
+      if(typ->AtoLok)
+         CatSiz[ LplMemLocks ] += (typ->NmbLok + 1) * sizeof(int);
+#endif
+
+      // Tuners' snapshots belong to the type whose blocks they saved
+      for(i=0;i<par->NmbTun;i++)
+      {
+         tun = &par->TunTab[i];
+
+         if(tun->SnpSiz && (tun->TypIdx1 == TypIdx))
+            CatSiz[ LplMemOthers ] += tun->SnpSiz;
+      }
+
+      return;
+   }
+
+   // Instance, threads, temporary WP and user stacks
+   CatSiz[ LplMemThreads ] += sizeof(ParSct) + (MaxTyp + 1) * sizeof(TypSct)
+         + par->NmbCpu * (sizeof(PthSct) + ItlSiz + 2 * sizeof(itg) + 3 * sizeof(int)
+         + sizeof(WrkSct *) + sizeof(uint64_t) + 2 * sizeof(double) + par->StkSiz)
+         + par->BufMax * sizeof(WrkSct *);
+
+   // Arenas' chunks are kept until the end
+   CatSiz[ LplMemPipelines ] += MaxTotPip / 32 * sizeof(int)
+         + par->PipArn.AlcSiz + par->StkArn.AlcSiz;
+
+   if(par->PipTab)
+      CatSiz[ LplMemPipelines ] += (MaxTotPip + 1) * sizeof(PipSct *);
+
+   CatSiz[ LplMemSchedules ] += par->GrpArn.AlcSiz;
+
+   // Colors and grains
+   if(par->GrnMat)
+      CatSiz[ LplMemGrains ] += (size_t)(par->NmbGrn + 1) * par->NmbDepWrd * sizeof(int);
+
+   if(par->GrnCol)
+      CatSiz[ LplMemGrains ] += (par->NmbGrn + 1) * sizeof(int);
+
+   if(par->GrnWrkTab)
+      CatSiz[ LplMemGrains ] += par->NmbGrn * sizeof(WrkSct);
+
+   if(par->RunDepTab)
+      CatSiz[ LplMemGrains ] += (par->NmbGrn / 32 + 1) * sizeof(int);
+
+   if(par->ColTab)
+      CatSiz[ LplMemGrains ] += (par->NmbCol + 1) * 2 * sizeof(int);
+
+   if(par->ColCpt)
+      CatSiz[ LplMemGrains ] += (par->NmbCol + 1) * sizeof(int);
+
+   for(i=0;i<LplMax;i++)
+      if(par->GrnTab[i])
+         CatSiz[ LplMemGrains ] += (par->NmbGrn + 1) * 2 * sizeof(int);
+
+   // Captured graphs
+   for(i=0;i<MaxGrf;i++)
+      CatSiz[ LplMemOthers ] += par->GrfTab[i].MaxCap * sizeof(CapSct);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Bytes taken by an area from AlcHug: the whole mapping or the requested     */
+/* size and the header of a regular allocation                                */
+/*----------------------------------------------------------------------------*/
+
+static size_t HugSiz(void *adr, size_t siz)
+{
+   HugSct *hug = (HugSct *)((char *)adr - CchLinSiz);
+
+   return(hug->MapSiz ? hug->MapSiz : siz + CchLinSiz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Replace a type's former sizes, or the instance's ones, with the current    */
+/* ones in the running totals and raise the peaks accordingly                 */
+/*----------------------------------------------------------------------------*/
+
+static void UpdMem(ParSct *par, int TypIdx)
+{
+   int      i;
+   size_t   CatSiz[ LplMemMax ], *OldSiz = par->MemTab[ TypIdx ];
+   LplMemSct *cur = &par->MemCur, *pek = &par->MemPek;
+
+   GetMem(par, TypIdx, CatSiz);
+
+   for(i=0;i<LplMemMax;i++)
+   {
+      cur->CatSiz[i] += CatSiz[i] - OldSiz[i];
+      cur->TotSiz += CatSiz[i] - OldSiz[i];
+      OldSiz[i] = CatSiz[i];
+      pek->CatPek[i] = MAX(pek->CatPek[i], cur->CatSiz[i]);
+   }
+
+   pek->TotPek = MAX(pek->TotPek, cur->TotSiz);
+
+   // The instance's tables belong to no type
+   if(!TypIdx)
+      return;
+
+   cur->TypSiz[ TypIdx ] = 0;
+
+   for(i=0;i<LplMemMax;i++)
+      cur->TypSiz[ TypIdx ] += CatSiz[i];
+
+   pek->TypPek[ TypIdx ] = MAX(pek->TypPek[ TypIdx ], cur->TypSiz[ TypIdx ]);
+}
+
+
 /*----------------------------------------------------------------------------*/
 /* Call the parallel version of qsort on macOS or the serial one otherwise    */
 /*----------------------------------------------------------------------------*/
@@ -3026,9 +9105,10 @@ int CmpPrc(const void *a, const void *b)
 int HilbertRenumbering( int64_t ParIdx, itg NmbLin, double box[6],
                         double (*crd)[3], uint64_t (*idx)[2] )
 {
-   int      i, NewTyp;
+   int      i, NewTyp, LchPol;
    double   len = pow(2,64);
    ArgSct   arg;
+   ParSct   *par = (ParSct *)ParIdx;
 
    // Get and check lib parallel instance
    if(!ParIdx)
@@ -3046,11 +9126,12 @@ int HilbertRenumbering( int64_t ParIdx, itg NmbLin, double box[6],
    arg.box[4] = len / (box[4] - box[1]);
    arg.box[5] = len / (box[5] - box[2]);
 
-
-   if(NmbLin < 10000)
-      RenPrc(1, NmbLin, 0, (void *)&arg);
-   else
-      LaunchParallel(ParIdx, NewTyp, 0, (void *)RenPrc, (void *)&arg);
+   // Let the launch policy decide between a serial and a parallel run
+   LchPol = par->LchPol;
+   par->LchPol = 1;
+   LaunchParallel64(ParIdx, NewTyp, 0, (void *)RenPrc, (void *)&arg);
+   par->LchPol = LchPol;
+   FreeType(ParIdx, NewTyp);
 
    qsort(&idx[1][0], NmbLin, 2 * sizeof(int64_t), CmpPrc);
 
@@ -3123,9 +9204,10 @@ int HilbertRenumbering2D(  int64_t ParIdx, itg NmbLin, double box[4],
                            double (*crd)[2], uint64_t (*idx)[2] )
 {
    itg i;
-   int NewTyp;
+   int NewTyp, LchPol;
    double len = pow(2,62);
    ArgSct arg;
+   ParSct *par = (ParSct *)ParIdx;
 
    // Get and check lib parallel instance
    if(!ParIdx)
@@ -3139,7 +9221,11 @@ int HilbertRenumbering2D(  int64_t ParIdx, itg NmbLin, double box[4],
    arg.box[2] = len / (box[2] - box[0]);
    arg.box[3] = len / (box[3] - box[1]);
 
-   LaunchParallel(ParIdx, NewTyp, 0, (void *)RenPrc2D, (void *)&arg);
+   LchPol = par->LchPol;
+   par->LchPol = 1;
+   LaunchParallel64(ParIdx, NewTyp, 0, (void *)RenPrc2D, (void *)&arg);
+   par->LchPol = LchPol;
+   FreeType(ParIdx, NewTyp);
    ParallelQsort(ParIdx, &idx[1][0], NmbLin, 2 * sizeof(int64_t), CmpPrc);
 
    for(i=1;i<=NmbLin;i++)
@@ -3167,6 +9253,136 @@ double GetWallClock()
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* Allocate a memory area backed by huge pages if possible                    */
+/*----------------------------------------------------------------------------*/
+
+void *LplAlloc(int64_t ParIdx, size_t siz, int flg)
+{
+   ParSct *par = (ParSct *)ParIdx;
+
+   if(!ParIdx || !siz)
+      return(NULL);
+
+   return(AlcHug(par->lmb, (int64_t)siz, flg));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free a memory area allocated by LplAlloc                                   */
+/*----------------------------------------------------------------------------*/
+
+void LplFree(int64_t ParIdx, void *adr)
+{
+   ParSct *par = (ParSct *)ParIdx;
+
+   if(!ParIdx || !adr)
+      return;
+
+   FreHug(par->lmb, adr);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Map an area spanning several huge pages with explicit huge pages, or       */
+/* with transparent ones on a huge page aligned mapping, small areas or       */
+/* failed mappings fall back to a regular allocation                          */
+/*----------------------------------------------------------------------------*/
+
+static void *AlcHug(void *lmb, int64_t siz, int flg)
+{
+   char     *adr = NULL;
+   HugSct   *hug;
+#ifdef __linux__
+   char     *MapAdr;
+   size_t   MapSiz, off;
+
+   MapSiz = ((siz + CchLinSiz + HugPagSiz - 1) / HugPagSiz) * HugPagSiz;
+
+   if( (flg & (LplHugePages | LplExplicitHugePages)) && (siz >= HugPagSiz) )
+   {
+      // Explicit huge pages need to be reserved by the system
+      if(flg & LplExplicitHugePages)
+      {
+         adr = mmap(NULL, MapSiz, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+         if(adr == MAP_FAILED)
+            adr = NULL;
+         else
+         {
+            hug = (HugSct *)adr;
+            hug->typ = HugExp;
+         }
+      }
+
+      // Transparent huge pages need an aligned area: map a larger one
+      // and unmap what stands before and after the aligned part
+      if(!adr)
+      {
+         MapAdr = mmap(NULL, MapSiz + HugPagSiz, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+         if(MapAdr != MAP_FAILED)
+         {
+            off = (HugPagSiz - (size_t)MapAdr % HugPagSiz) % HugPagSiz;
+            adr = MapAdr + off;
+
+            if(off)
+               munmap(MapAdr, off);
+
+            munmap(adr + MapSiz, HugPagSiz - off);
+            madvise(adr, MapSiz, MADV_HUGEPAGE);
+            hug = (HugSct *)adr;
+            hug->typ = HugTrn;
+         }
+      }
+
+      // Mappings are always cleared by the system
+      if(adr)
+      {
+         hug->MapSiz = MapSiz;
+         return(adr + CchLinSiz);
+      }
+   }
+#endif
+
+   if(flg & LplClearMemory)
+      adr = LPL_calloc(lmb, 1, siz + CchLinSiz);
+   else
+      adr = LPL_malloc(lmb, siz + CchLinSiz);
+
+   if(!adr)
+      return(NULL);
+
+   hug = (HugSct *)adr;
+   hug->typ = HugMal;
+   hug->MapSiz = 0;
+
+   return(adr + CchLinSiz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Unmap or free an area allocated by AlcHug                                  */
+/*----------------------------------------------------------------------------*/
+
+static void FreHug(void *lmb, void *adr)
+{
+   HugSct *hug = (HugSct *)((char *)adr - CchLinSiz);
+
+#ifdef __linux__
+   if(hug->typ != HugMal)
+   {
+      munmap(hug, hug->MapSiz);
+      return;
+   }
+#endif
+
+   LPL_free(lmb, hug);
+}
+
+
 /*----------------------------------------------------------------------------*/
 /* Encapsulate the selection between libMemBlock and regular libc malloc      */
 /*----------------------------------------------------------------------------*/
@@ -3260,153 +9476,66 @@ static void LPL_free(void *lmb, void *adr)
 
 
 /*----------------------------------------------------------------------------*/
-/* Call a C thread with 1 to 20 arguments                                     */
+/* Call the current procedure with the indices' width it was launched with    */
 /*----------------------------------------------------------------------------*/
 
-static void CalVarArgPrc(itg BegIdx, itg EndIdx, int PthIdx, ParSct *par)
+static void CalPrc(ParSct *par, itg BegIdx, itg EndIdx, int PthIdx)
 {
-   switch(par->NmbVarArg)
-   {
-      case 1 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 1)) =
-            (void (*)(itg, itg, int, DUP(void *, 1)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 1));
-      }break;
-
-      case 2 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 2)) =
-            (void (*)(itg, itg, int, DUP(void *, 2)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 2));
-      }break;
-
-      case 3 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 3)) =
-            (void (*)(itg, itg, int, DUP(void *, 3)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 3));
-      }break;
-
-      case 4 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 4)) =
-            (void (*)(itg, itg, int, DUP(void *, 4)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 4));
-      }break;
-
-      case 5 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 5)) =
-            (void (*)(itg, itg, int, DUP(void *, 5)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 5));
-      }break;
-
-      case 6 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 6)) =
-            (void (*)(itg, itg, int, DUP(void *, 6)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 6));
-      }break;
-
-      case 7 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 7)) =
-            (void (*)(itg, itg, int, DUP(void *, 7)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 7));
-      }break;
-
-      case 8 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 8)) =
-            (void (*)(itg, itg, int, DUP(void *, 8)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 8));
-      }break;
-
-      case 9 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 9)) =
-            (void (*)(itg, itg, int, DUP(void *, 9)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 9));
-      }break;
-
-      case 10 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 10)) =
-            (void (*)(itg, itg, int, DUP(void *, 10)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 10));
-      }break;
-
-      case 11 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 11)) =
-            (void (*)(itg, itg, int, DUP(void *, 11)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 11));
-      }break;
-
-      case 12 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 12)) =
-            (void (*)(itg, itg, int, DUP(void *, 12)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 12));
-      }break;
-
-      case 13 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 13)) =
-            (void (*)(itg, itg, int, DUP(void *, 13)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 13));
-      }break;
-
-      case 14 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 14)) =
-            (void (*)(itg, itg, int, DUP(void *, 14)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 14));
-      }break;
-
-      case 15 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 15)) =
-            (void (*)(itg, itg, int, DUP(void *, 15)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 15));
-      }break;
-
-      case 16 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 16)) =
-            (void (*)(itg, itg, int, DUP(void *, 16)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 16));
-      }break;
+   void (*prc32)(int32_t, int32_t, int, void *);
 
-      case 17 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 17)) =
-            (void (*)(itg, itg, int, DUP(void *, 17)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 17));
-      }break;
+   if(par->NmbVarArg)
+      CalVarArgPrc(BegIdx, EndIdx, PthIdx, par);
+   else if(par->PrcWid == LplInt)
+   {
+      prc32 = (void (*)(int32_t, int32_t, int, void *))(void (*)(void))par->prc;
+      prc32((int32_t)BegIdx, (int32_t)EndIdx, PthIdx, par->arg);
+   }
+   else
+      par->prc(BegIdx, EndIdx, PthIdx, par->arg);
+}
 
-      case 18 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 18)) =
-            (void (*)(itg, itg, int, DUP(void *, 18)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 18));
-      }break;
 
-      case 19 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 19)) =
-            (void (*)(itg, itg, int, DUP(void *, 19)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 19));
-      }break;
+/*----------------------------------------------------------------------------*/
+/* Call a C thread with 1 to 20 arguments, the cases are generated for each   */
+/* width of indices the procedure may have been launched with, the cast goes  */
+/* through a generic function pointer as the prototypes are known to differ   */
+/*----------------------------------------------------------------------------*/
+
+#define VarArgCas(t,n) \
+         case n : ((void (*)(t, t, int, DUP(void *, n)))(void (*)(void))par->prc) \
+                     ((t)BegIdx, (t)EndIdx, PthIdx, ARG(par->VarArgTab, n)); break;
+
+#define VarArgSwi(t) \
+      switch(par->NmbVarArg) \
+      { \
+         VarArgCas(t, 1) \
+         VarArgCas(t, 2) \
+         VarArgCas(t, 3) \
+         VarArgCas(t, 4) \
+         VarArgCas(t, 5) \
+         VarArgCas(t, 6) \
+         VarArgCas(t, 7) \
+         VarArgCas(t, 8) \
+         VarArgCas(t, 9) \
+         VarArgCas(t, 10) \
+         VarArgCas(t, 11) \
+         VarArgCas(t, 12) \
+         VarArgCas(t, 13) \
+         VarArgCas(t, 14) \
+         VarArgCas(t, 15) \
+         VarArgCas(t, 16) \
+         VarArgCas(t, 17) \
+         VarArgCas(t, 18) \
+         VarArgCas(t, 19) \
+         VarArgCas(t, 20) \
+      }
 
-      case 20 :
-      {
-         void (*prc1)(itg, itg, int, DUP(void *, 20)) =
-            (void (*)(itg, itg, int, DUP(void *, 20)))par->prc;
-         prc1(BegIdx, EndIdx, PthIdx, ARG(par->VarArgTab, 20));
-      }break;
-   }
+static void CalVarArgPrc(itg BegIdx, itg EndIdx, int PthIdx, ParSct *par)
+{
+   if(par->PrcWid == LplInt)
+      VarArgSwi(int32_t)
+   else
+      VarArgSwi(itg)
 }
 
 
@@ -3765,7 +9894,7 @@ LplSct *MeshRenumbering(int64_t ParIdx, int NmbGrn,
 
    SetBndBox(msh);
 
-   LaunchParallel(LibParIdx, RenVerTyp, 0, (void *)RenVer, (void *)msh);
+   LaunchParallel32(LibParIdx, RenVerTyp, 0, (void *)RenVer, (void *)msh);
    ParallelQsort(LibParIdx, msh->VerCod[1], msh->NmbVer, 2 * sizeof(int64_t), CmpFnc);
 
    for(i=1;i<=msh->NmbVer;i++)
@@ -3814,7 +9943,7 @@ LplSct *MeshRenumbering(int64_t ParIdx, int NmbGrn,
       msh->TypIdx = t;
       msh->EleCod[t] = malloc( (msh->NmbEle[t] + 1) * 2 * sizeof(int64_t) );
       assert(msh->EleCod[t]);
-      LaunchParallel(LibParIdx, RenEleTyp[t], 0, (void *)RenEle, (void *)msh);
+      LaunchParallel32(LibParIdx, RenEleTyp[t], 0, (void *)RenEle, (void *)msh);
       ParallelQsort(LibParIdx, msh->EleCod[t][1], msh->NmbEle[t], 2 * sizeof(int64_t), CmpFnc);
 
       siz = EleSiz[t];
@@ -4041,6 +10170,8 @@ LplSct *MeshRenumbering(int64_t ParIdx, int NmbGrn,
 
       for(i=0;i<par->NmbGrn;i++)
          par->GrnWrkTab[i].DepWrdTab = &par->GrnMat[ (i+1) * par->NmbDepWrd ];
+
+      UpdMem(par, 0);
    }
 
    // Free all working tables
@@ -5417,6 +11548,9 @@ int AllocAtomicLocks(int64_t ParIdx, int TypIdx)
    if(!typ->AtoLok)
       return(0);
 
+   typ->NmbLok = typ->NmbLin;
+   UpdMem(par, TypIdx);
+
    return(1);
 }
 
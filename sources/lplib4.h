@@ -53,6 +53,12 @@ enum LplTyp {  LplVer, LplEdg, LplTri, LplQad, LplTet, LplPyr, LplPri, LplHex,
 
 enum RenTyp {LplNoRenum, LplHilbert, LplZcurve};
 
+#define LplMaxTyp 100
+
+enum LplMemCat {  LplMemThreads, LplMemBlocks, LplMemDependencies,
+                  LplMemSchedules, LplMemGrains, LplMemLocks, LplMemPipelines,
+                  LplMemOthers, LplMemMax };
+
 
 /*----------------------------------------------------------------------------*/
 /* Structures                                                                 */
@@ -77,42 +83,65 @@ typedef struct
    double   MinSiz, MaxSiz, *CrdTab;
 }LplSct;
 
+// Bytes held by an instance, per category and per type, along with the
+// highest values they reached
+typedef struct
+{
+   size_t   TotSiz, TotPek;
+   size_t   CatSiz[ LplMemMax ], CatPek[ LplMemMax ];
+   size_t   TypSiz[ LplMaxTyp + 1 ], TypPek[ LplMaxTyp + 1 ];
+}LplMemSct;
+
 
 /*----------------------------------------------------------------------------*/
 /* User available procedures' prototypes                                      */
 /*----------------------------------------------------------------------------*/
 
-int      AddDependency              (int64_t, itg, itg);
-void     AddDependencyFast          (int64_t, int, itg *, int, itg *);
+int      AddDependency              (int64_t, int64_t, int64_t);
+void     AddDependencyFast32        (int64_t, int, int32_t *, int, int32_t *);
+void     AddDependencyFast64        (int64_t, int, int64_t *, int, int64_t *);
+int      AddDependencyTable32       (int64_t, int, int, int, int32_t *);
+int      AddDependencyTable64       (int64_t, int, int, int, int64_t *);
 int      BeginDependency            (int64_t, int, int);
+int      BeginDependencyMultiType   (int64_t, int, int, int *);
+int      AddDependencyMultiType     (int64_t, int, int64_t, int64_t);
+uint64_t ConnectivityChecksum32     (int64_t, int64_t, int, int32_t *);
+uint64_t ConnectivityChecksum64     (int64_t, int64_t, int, int64_t *);
+int      SaveDependencies           (int64_t, int, char *, uint64_t);
+int      LoadDependencies           (int64_t, int, char *, uint64_t, float [2]);
 int      EndDependency              (int64_t, float [2]);
 void     FreeType                   (int64_t, int);
 void     GetDependencyStats         (int64_t, int, int, float [2]);
 void     GetLplibInformation        (int64_t, int *, int *);
+int      GetMemoryUsage             (int64_t, LplMemSct *);
 int      GetNumberOfCores           ();
 double   GetWallClock               ();
-int      HilbertRenumbering         (int64_t, itg, double [6],
+int      HilbertRenumbering         (int64_t, int64_t, double [6],
                                      double (*)[3], uint64_t (*)[2]);
-int      HilbertRenumbering2D       (int64_t, itg, double [4],
+int      HilbertRenumbering2D       (int64_t, int64_t, double [4],
                                      double (*)[2], uint64_t (*)[2]);
 int64_t  InitParallel               (int);
 int64_t  InitParallelAttr           (int, size_t, void *);
-float    LaunchParallel             (int64_t, int, int, void *, void *);
-float    LaunchParallelMultiArg     (int64_t, int, int, void *, int, ...);
+float    LaunchParallel32           (int64_t, int, int, void *, void *);
+float    LaunchParallel64           (int64_t, int, int, void *, void *);
+float    LaunchParallelMultiArg32   (int64_t, int, int, void *, int, ...);
+float    LaunchParallelMultiArg64   (int64_t, int, int, void *, int, ...);
 int      LaunchPipeline             (int64_t, void *, void *, int, int *);
 int      LaunchPipelineMultiArg     (int64_t, int, int *, void *prc, int, ...);
-int      NewType                    (int64_t, itg);
+int      NewType                    (int64_t, int64_t);
 int      ParallelMemClear           (int64_t, void *, size_t);
 int      ParallelMemCopy            (int64_t, void *, void *, size_t);
+int      ParallelMemSet             (int64_t, void *, size_t, void *, size_t);
 int      ParallelOld2New64bits      (int64_t, int64_t, uint64_t (*)[2],
                                      void *, size_t);
 void     ParallelQsort              (int64_t, void *, size_t, size_t, 
                                      int (*)(const void *, const void *));
 int      RadixSort                  (int64_t, size_t, void*, int, void*, size_t);
-int      ResizeType                 (int64_t, int, itg);
+int      ResizeType                 (int64_t, int, int64_t);
 void     StopParallel               (int64_t);
-int      UpdateDependency           (int64_t, int, int, itg, itg);
-void     UpdateDependencyFast       (int64_t, int, int, itg *, int, int, itg *);
+int      UpdateDependency           (int64_t, int, int, int64_t, int64_t);
+void     UpdateDependencyFast32     (int64_t, int, int, int32_t *, int, int, int32_t *);
+void     UpdateDependencyFast64     (int64_t, int, int, int64_t *, int, int, int64_t *);
 void     WaitPipeline               (int64_t);
 int      GetBigBlkNfo               (int64_t, int, int, int *, int *);
 int      GetBlkIdx                  (int64_t, int, int);
@@ -120,14 +149,32 @@ int      ChkBlkDep                  (int64_t, int, int, int);
 int      SetExtendedAttributes      (int64_t , ...);
 int      HalveSmallBlocks           (int64_t, int, int);
 int      HalveDependencyBlocks      (int64_t, int, int);
-float    LaunchColorGrains          (int64_t, int, void *, void *);
-float    LaunchColorGrainsMultiArg  (int64_t, int, void *, int, ...);
+float    LaunchColorGrains32        (int64_t, int, void *, void *);
+float    LaunchColorGrains64        (int64_t, int, void *, void *);
+float    LaunchColorGrainsMultiArg32(int64_t, int, void *, int, ...);
+float    LaunchColorGrainsMultiArg64(int64_t, int, void *, int, ...);
 LplSct  *MeshRenumbering            (int64_t, int, int, int, int, ...);
 void     FreeNumberingStruct        (LplSct *);
 double   EvaluateRenumbering        (int, int, int *);
 int      RestoreNumbering           (LplSct *, int, double *, ...);
 int      GetOldIndex                (LplSct *, int, int);
 int      GetNewIndex                (LplSct *, int, int);
+int      SetProcedureCost           (int64_t, int, void *, double);
+int      SaveTuning                 (int64_t, char *);
+int      LoadTuning                 (int64_t, char *);
+int      SetEntitySize              (int64_t, int, size_t);
+int      GetCacheSizes              (int64_t, size_t *, size_t *, size_t *);
+int      SetEntityCost32            (int64_t, int, float *, float (*)(int32_t, void *), void *);
+int      SetEntityCost64            (int64_t, int, float *, float (*)(int64_t, void *), void *);
+int      SetEntityPriority          (int64_t, int, float *);
+int      SetPipelinePriority        (int64_t, int, float);
+int      BeginCapture               (int64_t);
+int      EndCapture                 (int64_t);
+int      ReplayGraph                (int64_t, int);
+void     FreeGraph                  (int64_t, int);
+void    *LplAlloc                   (int64_t, size_t, int);
+void     LplFree                    (int64_t, void *);
+void    *ParallelAlloc              (int64_t, int, size_t, int);
 
 #if ( __STDC_VERSION__ > 201100L )
 int      AllocAtomicLocks           (int64_t, int);
@@ -145,7 +192,26 @@ void     AtomicUnlock               (int64_t, int, int);
 /* Public defines                                                             */
 /*----------------------------------------------------------------------------*/
 
-#define MaxPth 256
+#define MaxPth 1024
+
+// Procedures taking the user's indices come in a 32 and a 64 bit flavour
+// built in the same library, the plain names select the one matching
+// the INT64 flag the user's code is compiled with
+#ifdef INT64
+#define LplWid(n) n ## 64
+#else
+#define LplWid(n) n ## 32
+#endif
+
+#define AddDependencyFast           LplWid(AddDependencyFast)
+#define AddDependencyTable          LplWid(AddDependencyTable)
+#define ConnectivityChecksum        LplWid(ConnectivityChecksum)
+#define LaunchParallel              LplWid(LaunchParallel)
+#define LaunchParallelMultiArg      LplWid(LaunchParallelMultiArg)
+#define LaunchColorGrains           LplWid(LaunchColorGrains)
+#define LaunchColorGrainsMultiArg   LplWid(LaunchColorGrainsMultiArg)
+#define SetEntityCost               LplWid(SetEntityCost)
+#define UpdateDependencyFast        LplWid(UpdateDependencyFast)
 
 enum ArgAtr {
    SetInterleavingFactor = 1,
@@ -157,7 +223,28 @@ enum ArgAtr {
    SetSmallBlock,
    SetDependencyBlock,
    EnableAdaptiveSizing,
-   DisableAdaptiveSizing
+   DisableAdaptiveSizing,
+   EnableLaunchPolicy,
+   DisableLaunchPolicy,
+   EnableAutoTuning,
+   DisableAutoTuning,
+   EnableCacheAffinity,
+   DisableCacheAffinity,
+   EnableScheduleReplay,
+   DisableScheduleReplay,
+   EnableOrderedDependencies,
+   DisableOrderedDependencies,
+   EnableCriticalPath,
+   DisableCriticalPath,
+   EnableAdaptiveTree,
+   DisableAdaptiveTree
+};
+
+enum LplAlcFlg {
+   LplClearMemory = 1,
+   LplHugePages = 2,
+   LplExplicitHugePages = 4,
+   LplInterleavedPages = 8
 };
 
 
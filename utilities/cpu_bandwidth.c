@@ -9,10 +9,11 @@
 /*   Description:       benchmarking code to evaluate memory bandwidth        */
 /*                      with various access patterns: direct, indirect,       */
 /*                      ragged tables and vectorized ragged tables            */
-/*                      direct and indirect memory reads                      */
+/*                      direct and indirect memory reads, with regular and    */
+/*                      huge memory pages                                     */
 /*   Author:            Loic MARECHAL                                         */
 /*   Creation date:     mar 20 2025                                           */
-/*   Last modification: jun 03 2025                                           */
+/*   Last modification: oct 18 2026                                           */
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
 
@@ -24,9 +25,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include "lplib4.h"
 #include "libmeshb8.h"
 
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
 
 /*----------------------------------------------------------------------------*/
 /* Defines                                                                    */
@@ -57,6 +65,70 @@ typedef struct
 #define MAX(a,b)        ((a) > (b) ? (a) : (b))
 
 
+/*----------------------------------------------------------------------------*/
+/* Open a data TLB misses counter for this process and the threads it will    */
+/* create, return -1 if performance counters are not available                */
+/*----------------------------------------------------------------------------*/
+
+int OpnTlb()
+{
+#ifdef __linux__
+   struct perf_event_attr atr;
+
+   memset(&atr, 0, sizeof(atr));
+   atr.size = sizeof(atr);
+   atr.type = PERF_TYPE_HW_CACHE;
+   atr.config =   PERF_COUNT_HW_CACHE_DTLB
+              | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+              | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+   atr.inherit = 1;
+   atr.exclude_kernel = 1;
+   atr.exclude_hv = 1;
+
+   return((int)syscall(__NR_perf_event_open, &atr, 0, -1, -1, 0));
+#else
+   return(-1);
+#endif
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Read the number of data TLB misses, -1 if not available                    */
+/*----------------------------------------------------------------------------*/
+
+int64_t GetTlb(int TlbIdx)
+{
+#ifdef __linux__
+   int64_t cpt;
+
+   if( (TlbIdx >= 0) && (read(TlbIdx, &cpt, sizeof(cpt)) == sizeof(cpt)) )
+      return(cpt);
+#endif
+   return(-1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Move an array to an area backed by huge pages                              */
+/*----------------------------------------------------------------------------*/
+
+void *HugCpy(int64_t ParIdx, void *adr, size_t siz)
+{
+   void *HugAdr;
+
+   if(!(HugAdr = LplAlloc(ParIdx, siz, LplHugePages)))
+   {
+      puts("Failed to allocate memory");
+      exit(1);
+   }
+
+   memcpy(HugAdr, adr, siz);
+   free(adr);
+
+   return(HugAdr);
+}
+
+
 /*----------------------------------------------------------------------------*/
 /* Loop over vertices, read and write data in a direct way                    */
 /*----------------------------------------------------------------------------*/
@@ -124,15 +196,88 @@ void RagMem(int BegIdx, int EndIdx, int PthIdx, MshSct *msh)
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* Launch direct and indirect memory access loops and store each loop's       */
+/* number of TLB misses                                                       */
+/*----------------------------------------------------------------------------*/
+
+void RunTst(MshSct *msh, int NmbItr, int64_t NmbBal, int TlbIdx, int64_t TlbTab[3])
+{
+   int      i;
+   int64_t  TlbCpt;
+   double   tim;
+
+   // -----------------------------
+   // RUN DIRECT ACCESS MEMORY TEST
+   // -----------------------------
+
+   // Perform parallel direct memory access loops on vertices and tets
+   TlbCpt = GetTlb(TlbIdx);
+   tim = GetWallClock();
+
+   for(i=1;i<=NmbItr;i++)
+   {
+      LaunchParallel(msh->ParIdx, msh->VerTyp, 0, (void *)DirMemVer, (void *)msh);
+      LaunchParallel(msh->ParIdx, msh->TetTyp, 0, (void *)DirMemTet, (void *)msh);
+   }
+
+   tim = GetWallClock() - tim;
+   TlbTab[0] = (TlbCpt >= 0) ? GetTlb(TlbIdx) - TlbCpt : -1;
+
+   printf("Direct reads   : %d steps, run time = %7.3fs, bandwidth = %6.1f GB/s, TLB misses = %lld\n",
+            NmbItr, tim, (NmbItr * (32LL * msh->NmbVer + 32LL * msh->NmbTet)) / (tim * 1E9),
+            (long long)TlbTab[0] );
+
+
+   // -------------------------------
+   // RUN INDIRECT ACCESS MEMORY TEST
+   // -------------------------------
+
+   // Perform parallel indirect memory access loops on tets
+   TlbCpt = GetTlb(TlbIdx);
+   tim = GetWallClock();
+
+   for(i=1;i<=NmbItr;i++)
+      LaunchParallel(msh->ParIdx, msh->TetTyp, 0, (void *)IndMem, (void *)msh);
+
+   tim = GetWallClock() - tim;
+   TlbTab[1] = (TlbCpt >= 0) ? GetTlb(TlbIdx) - TlbCpt : -1;
+
+   printf("Indirect reads : %d steps, run time = %7.3fs, bandwidth = %6.1f GB/s (unique reads = %6.1f GB/s), TLB misses = %lld\n",
+            NmbItr, tim, (NmbItr * 96LL * msh->NmbTet) / (tim * 1E9),
+            (NmbItr * (16LL * msh->NmbVer + 32LL * msh->NmbTet)) / (tim * 1E9),
+            (long long)TlbTab[1] );
+
+
+   // --------------------------------------
+   // RUN INDIRECT RAGGED ACCESS MEMORY TEST
+   // --------------------------------------
+
+   // Perform parallel ragged indirect memory access loops on vertices
+   TlbCpt = GetTlb(TlbIdx);
+   tim = GetWallClock();
+
+   for(i=1;i<=NmbItr;i++)
+      LaunchParallel(msh->ParIdx, msh->VerTyp, 0, (void *)RagMem, (void *)msh);
+
+   tim = GetWallClock() - tim;
+   TlbTab[2] = (TlbCpt >= 0) ? GetTlb(TlbIdx) - TlbCpt : -1;
+
+   printf("Ragged reads   : %d steps, run time = %7.3fs, bandwidth = %6.1f GB/s (unique reads = %6.1f GB/s), TLB misses = %lld\n",
+            NmbItr, tim, (NmbItr * (20LL * NmbBal + 24LL * msh->NmbVer)) / (tim * 1E9),
+            (NmbItr * (24LL * msh->NmbVer + 16LL * msh->NmbTet + 4LL * NmbBal)) / (tim * 1E9),
+            (long long)TlbTab[2] );
+}
+
+
 /*----------------------------------------------------------------------------*/
 /* Setup the LPlib and launch direct and indirect memory access loops         */
 /*----------------------------------------------------------------------------*/
 
 int main(int ArgCnt, char **ArgVec)
 {
-   int      i, j, k, ver, dim, ref, NmbCpu, NmbItr;
-   int64_t  InpMsh, NmbBal = 0;
-   double   tim;
+   int      i, j, k, ver, dim, ref, NmbCpu, NmbItr, TlbIdx;
+   int64_t  InpMsh, NmbBal = 0, RegTlb[3], HugTlb[3];
    char     *MshNam;
    MshSct   msh = {0};
 
@@ -208,6 +353,9 @@ int main(int ArgCnt, char **ArgVec)
    // INIT LPLIB
    // ----------
 
+   // Count the TLB misses of the threads the LPlib is about to create
+   TlbIdx = OpnTlb();
+
    // Initialize the LPlib and setup the data types
    msh.ParIdx = InitParallel(NmbCpu);
    msh.TetTyp = NewType(msh.ParIdx, msh.NmbTet);
@@ -262,72 +410,58 @@ int main(int ArgCnt, char **ArgVec)
       }
 
 
-   // -----------------------------
-   // RUN DIRECT ACCESS MEMORY TEST
-   // -----------------------------
-
-   // Perform parallel direct memory access loops on vertices and tets
-   tim = GetWallClock();
-
-   for(i=1;i<=NmbItr;i++)
-   {
-      LaunchParallel(msh.ParIdx, msh.VerTyp, 0, (void *)DirMemVer, (void *)&msh);
-      LaunchParallel(msh.ParIdx, msh.TetTyp, 0, (void *)DirMemTet, (void *)&msh);
-   }
-
-   tim = GetWallClock() - tim;
-
-   printf("Direct reads   : %d steps, run time = %7.3fs, bandwidth = %6.1f GB/s\n",
-            NmbItr, tim, (NmbItr * (32LL * msh.NmbVer + 32LL * msh.NmbTet)) / (tim * 1E9) );
-
-
-   // -------------------------------
-   // RUN INDIRECT ACCESS MEMORY TEST
-   // -------------------------------
-
-   // Perform parallel indirect memory access loops on tets
-   tim = GetWallClock();
-
-   for(i=1;i<=NmbItr;i++)
-      LaunchParallel(msh.ParIdx, msh.TetTyp, 0, (void *)IndMem, (void *)&msh);
-
-   tim = GetWallClock() - tim;
-
-   printf("Indirect reads : %d steps, run time = %7.3fs, bandwidth = %6.1f GB/s (unique reads = %6.1f GB/s)\n",
-            NmbItr, tim, (NmbItr * 96LL * msh.NmbTet) / (tim * 1E9),
-            (NmbItr * (16LL * msh.NmbVer + 32LL * msh.NmbTet)) / (tim * 1E9) );
-
-
    // --------------------------------------
-   // RUN INDIRECT RAGGED ACCESS MEMORY TEST
+   // RUN THE TESTS WITH REGULAR MEMORY PAGES
    // --------------------------------------
 
-   // Perform parallel ragged indirect memory access loops on vertices
-   tim = GetWallClock();
+   puts("Regular 4 KB memory pages:");
+   RunTst(&msh, NmbItr, NmbBal, TlbIdx, RegTlb);
 
-   for(i=1;i<=NmbItr;i++)
-      LaunchParallel(msh.ParIdx, msh.VerTyp, 0, (void *)RagMem, (void *)&msh);
 
-   tim = GetWallClock() - tim;
+   // -----------------------------------
+   // RUN THE TESTS WITH HUGE MEMORY PAGES
+   // -----------------------------------
 
-   printf("Ragged reads   : %d steps, run time = %7.3fs, bandwidth = %6.1f GB/s (unique reads = %6.1f GB/s)\n",
-            NmbItr, tim, (NmbItr * (20LL * NmbBal + 24LL * msh.NmbVer)) / (tim * 1E9),
-            (NmbItr * (24LL * msh.NmbVer + 16LL * msh.NmbTet + 4LL * NmbBal)) / (tim * 1E9) );
+   // Move the arrays to areas backed by huge pages
+   msh.TetVer = HugCpy(msh.ParIdx, msh.TetVer, (msh.NmbTet + 1) * sizeof(v4i));
+   msh.TetDat = HugCpy(msh.ParIdx, msh.TetDat, (msh.NmbTet + 1) * sizeof(v4f));
+   msh.VerCrd = HugCpy(msh.ParIdx, msh.VerCrd, (msh.NmbVer + 1) * sizeof(v4f));
+   msh.VerDat = HugCpy(msh.ParIdx, msh.VerDat, (msh.NmbVer + 1) * sizeof(v4f));
+   msh.VerDeg = HugCpy(msh.ParIdx, msh.VerDeg, (msh.NmbVer + 1) * sizeof(int));
+   msh.VerAdr = HugCpy(msh.ParIdx, msh.VerAdr, (msh.NmbVer + 1) * sizeof(int));
+   msh.VerBal = HugCpy(msh.ParIdx, msh.VerBal, NmbBal * sizeof(int));
+   msh.TetInt = (v4i *)msh.TetDat;
+
+   puts("\nHuge memory pages:");
+   RunTst(&msh, NmbItr, NmbBal, TlbIdx, HugTlb);
+
+   if( (RegTlb[1] > 0) && (RegTlb[2] > 0) )
+      printf("\nTLB misses reduction: direct %5.1f%%, indirect %5.1f%%, ragged %5.1f%%\n",
+               100. * (1. - (double)HugTlb[0] / (double)MAX(1, RegTlb[0])),
+               100. * (1. - (double)HugTlb[1] / (double)RegTlb[1]),
+               100. * (1. - (double)HugTlb[2] / (double)RegTlb[2]) );
+   else
+      puts("\nTLB misses counters are not available");
 
 
    // -------
    // CLEANUP
    // -------
 
+   LplFree(msh.ParIdx, msh.TetVer);
+   LplFree(msh.ParIdx, msh.TetDat);
+   LplFree(msh.ParIdx, msh.VerCrd);
+   LplFree(msh.ParIdx, msh.VerDat);
+   LplFree(msh.ParIdx, msh.VerDeg);
+   LplFree(msh.ParIdx, msh.VerAdr);
+   LplFree(msh.ParIdx, msh.VerBal);
+
    StopParallel(msh.ParIdx);
 
-   free(msh.TetVer);
-   free(msh.TetDat);
-   free(msh.VerCrd);
-   free(msh.VerDat);
-   free(msh.VerDeg);
-   free(msh.VerAdr);
-   free(msh.VerBal);
+#ifdef __linux__
+   if(TlbIdx >= 0)
+      close(TlbIdx);
+#endif
 
    return(0);
 }
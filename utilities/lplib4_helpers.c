@@ -92,10 +92,13 @@ itg ParallelBuildEdges( int NmbCpu, itg NmbEle, int EleTyp,
    if(EleTyp != LplTet)
       return(0);
 
-   // Setup LPlib and datatypes
+   // Setup LPlib and datatypes, the threads' parameters being sized
+   // for MaxPth threads
    if(!NmbCpu)
       NmbCpu = GetNumberOfCores();
 
+   NmbCpu = MIN(NmbCpu, MaxPth);
+
    LibIdx = InitParallel(NmbCpu);
    TetTyp = NewType(LibIdx, NmbEle);
 
@@ -319,10 +322,13 @@ int ParallelNeighbours( int NmbCpu, itg NmbEle, int EleTyp,
    if(EleTyp != LplTet)
       return(0);
 
-   // Setup LPlib and datatypes
+   // Setup LPlib and datatypes, the threads' parameters being sized
+   // for MaxPth threads
    if(!NmbCpu)
       NmbCpu = GetNumberOfCores();
 
+   NmbCpu = MIN(NmbCpu, MaxPth);
+
    if(!(LibIdx = InitParallel(NmbCpu)))
       return(0);
 
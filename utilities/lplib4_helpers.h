@@ -24,6 +24,9 @@
 
 #include <stdint.h>
 
+// The helpers are compiled along with the user's code and follow its INT64
+// flag, they do not come in 32 and 64 bit flavours like the library's
+// procedures: a program mixing both widths must call them from one only
 #ifdef INT64
 #define itg int64_t
 #else